@@ -0,0 +1,376 @@
+// sv_bench: abin::string_view 性能基准
+//
+// 对 find / rfind / find_first_of / compare / hash / substr 在不同 haystack/needle 尺寸下,
+// 分别测量 abin::string_view、std::string_view、std::string 与 libc 对应实现的耗时,
+// 并以 JSON 输出(ns/op 与 GB/s), 便于 CI 中做回归比较.
+//
+// 用法:
+//   sv_bench [--filter=<子串>] [--min-time-ms=<毫秒>] [--out=<文件>]
+//     --filter       只运行名称中包含该子串的用例(如 --filter=find_first_of)
+//     --min-time-ms  每个用例的最短测量时间, 默认 50ms
+//     --out          JSON 输出文件, 默认输出到 stdout
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "abin/string_view.h"
+
+namespace
+{
+
+// ---------- 防止编译器优化掉被测代码 ----------
+template <typename T>
+inline void do_not_optimize(const T &value)
+{
+#if defined(__GNUC__) || defined(__clang__)
+  asm volatile("" : : "r,m"(value) : "memory");
+#else
+  static volatile const void *sink;
+  sink = &value;
+#endif
+}
+
+struct result {
+  std::string op;
+  std::string impl;
+  std::string input;
+  size_t haystack;
+  size_t needle;
+  uint64_t iterations;
+  double ns_per_op;
+  double gb_per_s;
+};
+
+struct options {
+  std::string filter;
+  double min_time_ms = 50.0;
+  std::string out;
+};
+
+class runner
+{
+ public:
+  explicit runner(options opt) : opt_(std::move(opt)) {}
+
+  // bytes: 单次操作扫描的字节数, 用于换算 GB/s.
+  // 以模板参数接收被测函数, 使其在计时循环中内联; 经 std::function 间接调用的开销
+  // 在 16~64 字节的输入上会超过被测操作本身
+  template <typename F>
+  void run(const std::string &op, const std::string &impl, const std::string &input, size_t haystack, size_t needle,
+           size_t bytes, F fn)
+  {
+    const std::string name = op + "/" + impl + "/" + input;
+    if (!opt_.filter.empty() && name.find(opt_.filter) == std::string::npos) return;
+
+    using clock = std::chrono::steady_clock;
+    // 预热, 同时粗略估算单次耗时以确定批量大小
+    uint64_t batch = 1;
+    for (;;)
+    {
+      const auto t0 = clock::now();
+      for (uint64_t i = 0; i < batch; ++i) do_not_optimize(fn());
+      const double ns = std::chrono::duration<double, std::nano>(clock::now() - t0).count();
+      if (ns > 1e6 || batch >= (1ULL << 30)) break;
+      batch *= 2;
+    }
+
+    uint64_t iterations = 0;
+    double elapsed_ns = 0.0;
+    const double min_ns = opt_.min_time_ms * 1e6;
+    while (elapsed_ns < min_ns)
+    {
+      const auto t0 = clock::now();
+      for (uint64_t i = 0; i < batch; ++i) do_not_optimize(fn());
+      elapsed_ns += std::chrono::duration<double, std::nano>(clock::now() - t0).count();
+      iterations += batch;
+    }
+
+    const double ns_per_op = elapsed_ns / static_cast<double>(iterations);
+    const double gb_per_s = (ns_per_op > 0.0) ? static_cast<double>(bytes) / ns_per_op : 0.0;
+    results_.push_back({op, impl, input, haystack, needle, iterations, ns_per_op, gb_per_s});
+    std::fprintf(stderr, "%-48s %12.2f ns/op %10.3f GB/s\n", name.c_str(), ns_per_op, gb_per_s);
+  }
+
+  void write_json() const
+  {
+    FILE *f = opt_.out.empty() ? stdout : std::fopen(opt_.out.c_str(), "w");
+    if (f == nullptr)
+    {
+      std::fprintf(stderr, "sv_bench: cannot open %s\n", opt_.out.c_str());
+      std::exit(1);
+    }
+    std::fprintf(f, "{\n  \"benchmarks\": [\n");
+    for (size_t i = 0; i < results_.size(); ++i)
+    {
+      const result &r = results_[i];
+      std::fprintf(f,
+                   "    {\"op\": \"%s\", \"impl\": \"%s\", \"input\": \"%s\", \"haystack\": %zu, \"needle\": %zu, "
+                   "\"iterations\": %llu, \"ns_per_op\": %.4f, \"gb_per_s\": %.4f}%s\n",
+                   r.op.c_str(), r.impl.c_str(), r.input.c_str(), r.haystack, r.needle,
+                   static_cast<unsigned long long>(r.iterations), r.ns_per_op, r.gb_per_s,
+                   (i + 1 < results_.size()) ? "," : "");
+    }
+    std::fprintf(f, "  ]\n}\n");
+    if (f != stdout) std::fclose(f);
+  }
+
+ private:
+  options opt_;
+  std::vector<result> results_;
+};
+
+// ---------- 输入数据 ----------
+// 伪随机小写字母文本, 固定种子保证每次运行输入一致
+std::string random_text(size_t n, uint32_t seed)
+{
+  std::string s(n, '\0');
+  for (size_t i = 0; i < n; ++i)
+  {
+    seed = seed * 1664525U + 1013904223U;
+    s[i] = static_cast<char>('a' + (seed >> 24) % 26);
+  }
+  return s;
+}
+
+const size_t kHaystackSizes[] = {16, 256, 4096, 65536, 1 << 20};
+const size_t kNeedleSizes[] = {1, 4, 16, 64};
+
+void bench_find_char(runner &r)
+{
+  for (size_t n : kHaystackSizes)
+  {
+    // 目标字符只出现在末尾: 最坏情况下的全量扫描
+    std::string hay(n, 'a');
+    hay.back() = 'z';
+    const std::string input = "tail_hit_" + std::to_string(n);
+    abin::string_view a(hay);
+    std::string_view s(hay);
+    r.run("find_char", "abin", input, n, 1, n, [&] { return a.find('z'); });
+    r.run("find_char", "std_sv", input, n, 1, n, [&] { return s.find('z'); });
+    r.run("find_char", "std_string", input, n, 1, n, [&] { return hay.find('z'); });
+    r.run("find_char", "libc_memchr", input, n, 1, n, [&] {
+      const void *p = std::memchr(hay.data(), 'z', hay.size());
+      return p != nullptr ? static_cast<size_t>(static_cast<const char *>(p) - hay.data()) : std::string::npos;
+    });
+  }
+}
+
+void bench_find_substr(runner &r)
+{
+  for (size_t n : kHaystackSizes)
+  {
+    for (size_t m : kNeedleSizes)
+    {
+      if (m > n) continue;
+      // 随机文本, needle 取自末尾且以文本中不出现的 '#' 结尾, 确保需要扫描全部 haystack
+      std::string hay = random_text(n, 42);
+      hay.back() = '#';
+      const std::string needle = hay.substr(n - m);
+      const std::string input = "random_" + std::to_string(n) + "_" + std::to_string(m);
+      abin::string_view a(hay);
+      abin::string_view an(needle);
+      std::string_view s(hay);
+      std::string_view sn(needle);
+      r.run("find", "abin", input, n, m, n, [&] { return a.find(an); });
+      r.run("find", "std_sv", input, n, m, n, [&] { return s.find(sn); });
+      r.run("find", "std_string", input, n, m, n, [&] { return hay.find(needle); });
+#if defined(__GLIBC__) || defined(__APPLE__)
+      r.run("find", "libc_memmem", input, n, m, n, [&] {
+        const void *p = memmem(hay.data(), hay.size(), needle.data(), needle.size());
+        return p != nullptr ? static_cast<size_t>(static_cast<const char *>(p) - hay.data()) : std::string::npos;
+      });
+#endif
+      r.run("find", "libc_strstr", input, n, m, n, [&] {
+        const char *p = std::strstr(hay.c_str(), needle.c_str());
+        return p != nullptr ? static_cast<size_t>(p - hay.c_str()) : std::string::npos;
+      });
+    }
+  }
+
+  // 对抗输入: "aaaa...a" 中查找 "aaa...ab", 朴素算法退化为 O(n*m)
+  for (size_t n : kHaystackSizes)
+  {
+    for (size_t m : kNeedleSizes)
+    {
+      if (m < 2 || m > n) continue;
+      const std::string hay(n, 'a');
+      std::string needle(m - 1, 'a');
+      needle += 'b';
+      const std::string input = "adversarial_" + std::to_string(n) + "_" + std::to_string(m);
+      abin::string_view a(hay);
+      abin::string_view an(needle);
+      std::string_view s(hay);
+      std::string_view sn(needle);
+      r.run("find", "abin", input, n, m, n, [&] { return a.find(an); });
+      r.run("find", "std_sv", input, n, m, n, [&] { return s.find(sn); });
+      r.run("find", "std_string", input, n, m, n, [&] { return hay.find(needle); });
+#if defined(__GLIBC__) || defined(__APPLE__)
+      r.run("find", "libc_memmem", input, n, m, n, [&] {
+        const void *p = memmem(hay.data(), hay.size(), needle.data(), needle.size());
+        return p != nullptr ? static_cast<size_t>(static_cast<const char *>(p) - hay.data()) : std::string::npos;
+      });
+#endif
+    }
+  }
+}
+
+void bench_rfind(runner &r)
+{
+  for (size_t n : kHaystackSizes)
+  {
+    for (size_t m : kNeedleSizes)
+    {
+      if (m > n) continue;
+      // needle 取自开头且以文本中不出现的 '#' 开头, rfind 需要从末尾扫描到开头
+      std::string hay = random_text(n, 7);
+      hay.front() = '#';
+      const std::string needle = hay.substr(0, m);
+      const std::string input = "random_" + std::to_string(n) + "_" + std::to_string(m);
+      abin::string_view a(hay);
+      abin::string_view an(needle);
+      std::string_view s(hay);
+      std::string_view sn(needle);
+      r.run("rfind", "abin", input, n, m, n, [&] { return a.rfind(an); });
+      r.run("rfind", "std_sv", input, n, m, n, [&] { return s.rfind(sn); });
+      r.run("rfind", "std_string", input, n, m, n, [&] { return hay.rfind(needle); });
+    }
+  }
+}
+
+void bench_find_first_of(runner &r)
+{
+  const size_t set_sizes[] = {1, 4, 16};
+  for (size_t n : kHaystackSizes)
+  {
+    for (size_t k : set_sizes)
+    {
+      // haystack 为小写字母, 字符集合为不出现的字符外加末尾的一个命中字符
+      std::string hay = random_text(n, 99);
+      hay.back() = '!';
+      std::string set = std::string("0123456789ABCDEF").substr(0, k - 1) + "!";
+      const std::string input = "set_" + std::to_string(n) + "_" + std::to_string(k);
+      abin::string_view a(hay);
+      abin::string_view as(set);
+      std::string_view s(hay);
+      std::string_view ss(set);
+      r.run("find_first_of", "abin", input, n, k, n, [&] { return a.find_first_of(as); });
+      r.run("find_first_of", "std_sv", input, n, k, n, [&] { return s.find_first_of(ss); });
+      r.run("find_first_of", "std_string", input, n, k, n, [&] { return hay.find_first_of(set); });
+      r.run("find_first_of", "libc_strcspn", input, n, k, n,
+            [&] { return std::strcspn(hay.c_str(), set.c_str()); });
+    }
+  }
+}
+
+void bench_compare(runner &r)
+{
+  for (size_t n : kHaystackSizes)
+  {
+    // 两个内容相同但地址不同的字符串, 仅最后一个字节不同
+    const std::string lhs = random_text(n, 5);
+    std::string rhs = lhs;
+    rhs.back() = static_cast<char>(rhs.back() + 1);
+    const std::string input = "last_byte_" + std::to_string(n);
+    abin::string_view a(lhs);
+    abin::string_view b(rhs);
+    std::string_view s(lhs);
+    std::string_view t(rhs);
+    r.run("compare", "abin", input, n, n, n, [&] { return static_cast<size_t>(a.compare(b)); });
+    r.run("compare", "std_sv", input, n, n, n, [&] { return static_cast<size_t>(s.compare(t)); });
+    r.run("compare", "std_string", input, n, n, n, [&] { return static_cast<size_t>(lhs.compare(rhs)); });
+    r.run("compare", "libc_memcmp", input, n, n, n,
+          [&] { return static_cast<size_t>(std::memcmp(lhs.data(), rhs.data(), n)); });
+  }
+}
+
+void bench_hash(runner &r)
+{
+  for (size_t n : kHaystackSizes)
+  {
+    const std::string str = random_text(n, 11);
+    const std::string input = "random_" + std::to_string(n);
+    abin::string_view a(str);
+    std::string_view s(str);
+    r.run("hash", "abin", input, n, 0, n, [&] { return std::hash<abin::string_view>()(a); });
+    r.run("hash", "std_sv", input, n, 0, n, [&] { return std::hash<std::string_view>()(s); });
+    r.run("hash", "std_string", input, n, 0, n, [&] { return std::hash<std::string>()(str); });
+  }
+}
+
+void bench_substr(runner &r)
+{
+  const std::string str = random_text(4096, 3);
+  abin::string_view a(str);
+  std::string_view s(str);
+  const size_t lengths[] = {8, 64, 1024};
+  for (size_t m : lengths)
+  {
+    const std::string input = "len_" + std::to_string(m);
+    size_t pos = 0;
+    r.run("substr", "abin", input, str.size(), m, m, [&] {
+      pos = (pos + 17) & 1023;
+      return a.substr(pos, m).size();
+    });
+    r.run("substr", "std_sv", input, str.size(), m, m, [&] {
+      pos = (pos + 17) & 1023;
+      return s.substr(pos, m).size();
+    });
+    // std::string::substr 需要分配并拷贝, 作为对照
+    r.run("substr", "std_string", input, str.size(), m, m, [&] {
+      pos = (pos + 17) & 1023;
+      return str.substr(pos, m).size();
+    });
+  }
+}
+
+bool parse_args(int argc, char **argv, options &opt)
+{
+  for (int i = 1; i < argc; ++i)
+  {
+    const std::string arg = argv[i];
+    if (arg.compare(0, 9, "--filter=") == 0)
+    {
+      opt.filter = arg.substr(9);
+    }
+    else if (arg.compare(0, 14, "--min-time-ms=") == 0)
+    {
+      opt.min_time_ms = std::atof(arg.c_str() + 14);
+    }
+    else if (arg.compare(0, 6, "--out=") == 0)
+    {
+      opt.out = arg.substr(6);
+    }
+    else
+    {
+      std::fprintf(stderr, "usage: %s [--filter=<substr>] [--min-time-ms=<ms>] [--out=<file>]\n", argv[0]);
+      return false;
+    }
+  }
+  return true;
+}
+
+}  // namespace
+
+int main(int argc, char **argv)
+{
+  options opt;
+  if (!parse_args(argc, argv, opt)) return 1;
+
+  runner r(opt);
+  bench_find_char(r);
+  bench_find_substr(r);
+  bench_rfind(r);
+  bench_find_first_of(r);
+  bench_compare(r);
+  bench_hash(r);
+  bench_substr(r);
+  r.write_json();
+  return 0;
+}
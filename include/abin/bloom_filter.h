@@ -0,0 +1,480 @@
+/**************************************************************************************************************
+ *~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ * @file: bloom_filter.h
+ * @description: 以 abin::string_view 为键的分块 Bloom 过滤器, 用于在查询大字典前快速排除不存在的键.
+ * - may_contain 返回 false 表示键一定不存在; 返回 true 表示可能存在(假阳性率约为构造时给定的值).
+ * - 分块(blocked)布局: 每个键只落在一个 64 字节的块(一条缓存行)中, 一次查询最多一次缓存未命中;
+ *   键的 64 位 hash 的高 32 位选择块, 再把 hash 重新混合后每 9 位在块内选择一个位, 共 k 个.
+ *   分块会提高假阳性率, 因此按分块假阳性率模型(块内键数服从 Poisson 分布)选择 k 与每键位数,
+ *   在 [1e-6, 0.5] 范围内达到目标假阳性率; 位数比标准 Bloom 过滤器多约 3% ~ 35%(目标越低越多).
+ * - may_contain_many 批量查询: 先计算一批键的 hash 并预取各自的块, 再依次判断, 隐藏内存延迟.
+ * - serialize 输出一段扁平的字节序列(64 字节头 + 块数组), bloom_filter_view 可以直接在这段内存上查询,
+ *   例如 mmap 一个文件后构造视图, 无需反序列化或拷贝. 字节序为本机字节序.
+ *~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ **************************************************************************************************************/
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+#include "abin/detail/simd.h"
+#include "abin/string_view.h"
+
+namespace abin
+{
+
+namespace detail
+{
+
+inline uint64_t rotl64(uint64_t x, int r) noexcept
+{
+  return (x << r) | (x >> (64 - r));
+}
+
+// MurmurHash3 的 64 位终结函数
+inline uint64_t fmix64(uint64_t k) noexcept
+{
+  k ^= k >> 33;
+  k *= 0xFF51AFD7ED558CCDULL;
+  k ^= k >> 33;
+  k *= 0xC4CEB9FE1A85EC53ULL;
+  k ^= k >> 33;
+  return k;
+}
+
+/**
+ * @brief 64 位键 hash, 每次处理 8 字节(Murmur 风格的乘法与循环移位混合)
+ * @note 与 std::hash<abin::string_view> 不同, 各位分布均匀, 适合直接切分使用
+ */
+inline uint64_t key_hash64(const char *p, size_t n) noexcept
+{
+  const uint64_t c1 = 0x87C37B91114253D5ULL;
+  const uint64_t c2 = 0x4CF5AD432745937FULL;
+  uint64_t h = 0x9E3779B97F4A7C15ULL ^ (n * c1);
+  size_t i = 0;
+  for (; i + 8 <= n; i += 8)
+  {
+    const uint64_t k = rotl64(load_u64(p + i) * c1, 31) * c2;
+    h = rotl64(h ^ k, 27) * c1 + 0x52DCE729;
+    h ^= h >> 29;
+  }
+  uint64_t tail = 0;
+  for (size_t j = n; j-- > i;) tail = (tail << 8) | static_cast<unsigned char>(p[j]);
+  h ^= rotl64(tail * c2, 33) * c1;
+  return fmix64(h);
+}
+
+}  // namespace detail
+
+class bloom_filter;
+
+// ---------- bloom_filter_view 类 ----------
+// 在一段序列化后的字节(或 bloom_filter 的内部存储)上查询, 不拥有内存
+class bloom_filter_view
+{
+ public:
+  enum : size_t {
+    block_bytes = 64,               // 块大小, 等于常见的缓存行大小
+    block_bits = block_bytes * 8,   // 每块 512 位
+    block_words = block_bytes / 8,  // 每块 8 个 64 位字
+    header_bytes = 64,              // 序列化头的大小
+    format_version = 2,             // 序列化格式版本; 块内位置的取法改变时递增
+    max_hash_count = 16,            // 每个键最多设置的位数
+    batch_size = 16                 // may_contain_many 每批预取的键数
+  };
+
+  bloom_filter_view() noexcept : blocks_(nullptr), block_count_(0), hash_count_(0) {}
+
+  /**
+   * @brief 在 bloom_filter::serialize 输出的字节序列上构造视图
+   * @param bytes 序列化数据, 起始地址必须按 8 字节对齐(mmap 得到的内存满足此要求), 使用期间必须保持有效
+   * @note 数据格式不正确时 valid() 为 false
+   */
+  explicit bloom_filter_view(string_view bytes) noexcept : bloom_filter_view()
+  {
+    if (bytes.size() < header_bytes || reinterpret_cast<uintptr_t>(bytes.data()) % 8 != 0) return;
+    header h;
+    std::memcpy(&h, bytes.data(), sizeof(h));
+    if (std::memcmp(h.magic, "ABINBLM1", sizeof(h.magic)) != 0 || h.version != format_version) return;
+    if (h.hash_count == 0 || h.hash_count > max_hash_count || h.block_count == 0) return;
+    if (h.block_count > (bytes.size() - header_bytes) / block_bytes) return;
+    if (bytes.size() != header_bytes + h.block_count * block_bytes) return;
+    blocks_ = reinterpret_cast<const uint64_t *>(bytes.data() + header_bytes);
+    block_count_ = static_cast<size_t>(h.block_count);
+    hash_count_ = h.hash_count;
+  }
+
+  bool valid() const noexcept
+  {
+    return blocks_ != nullptr;
+  }
+
+  size_t block_count() const noexcept
+  {
+    return block_count_;
+  }
+
+  // 每个键设置的位数 k
+  unsigned hash_count() const noexcept
+  {
+    return hash_count_;
+  }
+
+  /**
+   * @brief 判断键是否可能存在
+   * @return false 表示一定不存在; 视图无效时返回 true(无法排除任何键)
+   */
+  bool may_contain(string_view key) const noexcept
+  {
+    if (!valid()) return true;
+    return probe(detail::key_hash64(key.data(), key.size()));
+  }
+
+  /**
+   * @brief 批量判断
+   * @param keys 键数组
+   * @param count 键个数
+   * @param results 输出数组(长度至少为 count), results[i] 为 may_contain(keys[i])
+   * @return 可能存在的键个数
+   */
+  size_t may_contain_many(const string_view *keys, size_t count, bool *results) const noexcept
+  {
+    if (!valid())
+    {
+      std::fill(results, results + count, true);
+      return count;
+    }
+    size_t hits = 0;
+    uint64_t hashes[batch_size];
+    for (size_t base = 0; base < count; base += batch_size)
+    {
+      const size_t m = std::min<size_t>(batch_size, count - base);
+      for (size_t i = 0; i < m; ++i)
+      {
+        hashes[i] = detail::key_hash64(keys[base + i].data(), keys[base + i].size());
+        detail::prefetch(block_of(hashes[i]));
+      }
+      for (size_t i = 0; i < m; ++i)
+      {
+        results[base + i] = probe(hashes[i]);
+        hits += results[base + i] ? 1 : 0;
+      }
+    }
+    return hits;
+  }
+
+ private:
+  friend class bloom_filter;
+
+  // 序列化头, 共 64 字节
+  struct header {
+    char magic[8];
+    uint32_t version;
+    uint32_t hash_count;
+    uint64_t block_count;
+    uint64_t key_count;
+    uint64_t reserved[4];
+  };
+
+  bloom_filter_view(const uint64_t *blocks, size_t block_count, unsigned hash_count) noexcept :
+    blocks_(blocks), block_count_(block_count), hash_count_(hash_count)
+  {
+  }
+
+  // 高 32 位按 multiply-shift 映射到 [0, block_count)
+  size_t block_index(uint64_t h) const noexcept
+  {
+    return static_cast<size_t>(((h >> 32) * static_cast<uint64_t>(block_count_)) >> 32);
+  }
+
+  const uint64_t *block_of(uint64_t h) const noexcept
+  {
+    return blocks_ + block_index(h) * block_words;
+  }
+
+  // 块内位置的来源: 由 h 重新混合得到, 与选择块的高 32 位无关
+  static uint64_t bit_source(uint64_t h) noexcept
+  {
+    return detail::fmix64(h ^ 0x9E3779B97F4A7C15ULL);
+  }
+
+  // 依次取出块内的 k 个位置, 每个位置 9 位; 用完 64 位后由完整的种子派生下一个 64 位
+  // (不能用移位后剩余的位派生, 那样第 8 个及以后的位置对所有键几乎相同)
+  template <typename F>
+  static bool for_each_bit(uint64_t h, unsigned k, F f) noexcept
+  {
+    uint64_t seed = bit_source(h);
+    uint64_t g = seed;
+    unsigned left = 7;  // 64 位中可取 7 个 9 位的位置
+    for (unsigned i = 0; i < k; ++i)
+    {
+      if (left == 0)
+      {
+        seed += 0x9E3779B97F4A7C15ULL;
+        g = detail::fmix64(seed);
+        left = 7;
+      }
+      if (!f(static_cast<unsigned>(g & (block_bits - 1)))) return false;
+      g >>= 9;
+      --left;
+    }
+    return true;
+  }
+
+  bool probe(uint64_t h) const noexcept
+  {
+    const uint64_t *block = block_of(h);
+    return for_each_bit(h, hash_count_, [block](unsigned bit) {
+      return (block[bit / 64] & (uint64_t{1} << (bit % 64))) != 0;
+    });
+  }
+
+  const uint64_t *blocks_;
+  size_t block_count_;
+  unsigned hash_count_;
+};
+
+// ---------- bloom_filter 类 ----------
+class bloom_filter
+{
+ public:
+  /**
+   * @brief 构造空过滤器
+   * @param expected_keys 预计插入的键数
+   * @param fp_rate 目标假阳性率(期望值), 会被限制在 [1e-6, 0.5]
+   */
+  explicit bloom_filter(size_t expected_keys, double fp_rate = 0.01) : key_count_(0)
+  {
+    init(expected_keys, fp_rate);
+  }
+
+  /**
+   * @brief 由一组键构造过滤器
+   * @param first 键序列起点, 元素可转换为 string_view
+   * @param last 键序列终点
+   * @param fp_rate 目标假阳性率
+   */
+  template <typename It>
+  bloom_filter(It first, It last, double fp_rate = 0.01) : key_count_(0)
+  {
+    init(static_cast<size_t>(std::distance(first, last)), fp_rate);
+    for (; first != last; ++first) add(*first);
+  }
+
+  // 拷贝时重新对齐块数组(新存储的对齐偏移可能不同)
+  bloom_filter(const bloom_filter &other) :
+    words_(other.words_.size(), 0),
+    block_count_(other.block_count_),
+    hash_count_(other.hash_count_),
+    key_count_(other.key_count_)
+  {
+    std::memcpy(blocks(), other.blocks(), block_count_ * bloom_filter_view::block_bytes);
+  }
+
+  bloom_filter &operator=(const bloom_filter &other)
+  {
+    if (this != &other)
+    {
+      bloom_filter copy(other);
+      *this = std::move(copy);
+    }
+    return *this;
+  }
+
+  bloom_filter(bloom_filter &&) noexcept = default;
+  bloom_filter &operator=(bloom_filter &&) noexcept = default;
+
+  void add(string_view key) noexcept
+  {
+    const uint64_t h = detail::key_hash64(key.data(), key.size());
+    const bloom_filter_view v = view();
+    uint64_t *block = blocks() + v.block_index(h) * bloom_filter_view::block_words;
+    bloom_filter_view::for_each_bit(h, hash_count_, [block](unsigned bit) {
+      block[bit / 64] |= uint64_t{1} << (bit % 64);
+      return true;
+    });
+    ++key_count_;
+  }
+
+  bool may_contain(string_view key) const noexcept
+  {
+    return view().may_contain(key);
+  }
+
+  size_t may_contain_many(const string_view *keys, size_t count, bool *results) const noexcept
+  {
+    return view().may_contain_many(keys, count, results);
+  }
+
+  // 指向内部存储的查询视图, 过滤器析构或移动后失效
+  bloom_filter_view view() const noexcept
+  {
+    return bloom_filter_view(blocks(), block_count_, hash_count_);
+  }
+
+  size_t block_count() const noexcept
+  {
+    return block_count_;
+  }
+
+  unsigned hash_count() const noexcept
+  {
+    return hash_count_;
+  }
+
+  // 已插入的键数(重复插入重复计数)
+  size_t key_count() const noexcept
+  {
+    return key_count_;
+  }
+
+  // serialize 输出的字节数
+  size_t serialized_size() const noexcept
+  {
+    return bloom_filter_view::header_bytes + block_count_ * bloom_filter_view::block_bytes;
+  }
+
+  /**
+   * @brief 序列化为扁平字节序列, 可写入文件后 mmap 回来, 用 bloom_filter_view 直接查询
+   * @param out 输出缓冲区, 至少 serialized_size() 字节
+   * @return 写出的字节数
+   */
+  size_t serialize(char *out) const noexcept
+  {
+    bloom_filter_view::header h;
+    std::memset(&h, 0, sizeof(h));
+    std::memcpy(h.magic, "ABINBLM1", sizeof(h.magic));
+    h.version = bloom_filter_view::format_version;
+    h.hash_count = hash_count_;
+    h.block_count = block_count_;
+    h.key_count = key_count_;
+    std::memcpy(out, &h, sizeof(h));
+    std::memcpy(out + sizeof(h), blocks(), block_count_ * bloom_filter_view::block_bytes);
+    return serialized_size();
+  }
+
+ private:
+  static_assert(sizeof(bloom_filter_view::header) == bloom_filter_view::header_bytes, "header must be 64 bytes");
+
+  /**
+   * @brief 分块 Bloom 过滤器的假阳性率模型
+   * @param load 平均每块的键数 λ; 每块的实际键数近似服从 Poisson(λ)
+   * @param k 每个键设置的位数
+   * @return 期望的假阳性率
+   * @note 块内有 i 个键时共投掷 m = k*i 次, 查询的 k 个位置覆盖 j 个不同的位, 它们全部被置位的概率
+   *       由容斥给出: sum_t (-1)^t C(j, t) (1 - t/B)^m. 与常用的 (1 - e^(-km/B))^k 近似不同,
+   *       这里计入了查询位置重合以及块内置位数的波动, k 较大时后者会使近似值明显偏低.
+   */
+  static double blocked_fp_rate(double load, unsigned k) noexcept
+  {
+    const double b = static_cast<double>(bloom_filter_view::block_bits);
+    // cover[j]: k 次均匀投掷恰好覆盖 j 个不同位置的概率
+    double cover[bloom_filter_view::max_hash_count + 1] = {1.0};
+    for (unsigned t = 0; t < k; ++t)
+    {
+      for (unsigned j = t + 1; j > 0; --j) cover[j] = cover[j] * (j / b) + cover[j - 1] * ((b - (j - 1)) / b);
+      cover[0] = 0.0;
+    }
+    // coef[t] = (-1)^t sum_j cover[j] C(j, t), 块内有 i 个键时的假阳性率为 sum_t coef[t] (1 - t/B)^(k*i)
+    double coef[bloom_filter_view::max_hash_count + 1] = {};
+    for (unsigned j = 1; j <= k; ++j)
+    {
+      double binom = 1.0;
+      for (unsigned t = 0; t <= j; ++t)
+      {
+        coef[t] += ((t & 1) != 0 ? -1.0 : 1.0) * cover[j] * binom;
+        binom = binom * (j - t) / (t + 1);
+      }
+    }
+    const double spread = 12.0 * std::sqrt(load) + 16.0;
+    const auto lo = static_cast<size_t>(std::max(0.0, load - spread));
+    const auto hi = static_cast<size_t>(load + spread);
+    double keep[bloom_filter_view::max_hash_count + 1];  // (1 - t/B)^(k*i), 随 i 递推
+    double step[bloom_filter_view::max_hash_count + 1];
+    for (unsigned t = 0; t <= k; ++t)
+    {
+      const double per_key = static_cast<double>(k) * std::log1p(-static_cast<double>(t) / b);
+      keep[t] = std::exp(per_key * static_cast<double>(lo));
+      step[t] = std::exp(per_key);
+    }
+    const double x0 = static_cast<double>(lo);
+    double poisson = std::exp(x0 * std::log(load) - load - std::lgamma(x0 + 1.0));
+    double rate = 0.0;
+    for (size_t i = lo; i <= hi; ++i)
+    {
+      double q = 0.0;
+      for (unsigned t = 0; t <= k; ++t)
+      {
+        q += coef[t] * keep[t];
+        keep[t] *= step[t];
+      }
+      rate += poisson * std::max(0.0, q);
+      poisson *= load / static_cast<double>(i + 1);
+    }
+    return rate;
+  }
+
+  void init(size_t expected_keys, double fp_rate)
+  {
+    fp_rate = std::min(0.5, std::max(1e-6, fp_rate));
+    // 按模型为每个候选 k 二分出满足 fp_rate 的最大每块键数, 取其中最大者(即每键位数最少)
+    const double k0 = -std::log2(fp_rate);  // 标准 Bloom 过滤器的最优 k
+    const auto k_hi = static_cast<unsigned>(std::min<double>(bloom_filter_view::max_hash_count, std::ceil(k0)));
+    const unsigned k_lo = k_hi > 6 ? k_hi - 6 : 1;
+    // 分块过滤器需要的位数不少于标准 Bloom 过滤器(每键 -ln(p) / ln(2)^2 位), 以此作为二分上界
+    const double ln2 = 0.6931471805599453;
+    const double max_load = bloom_filter_view::block_bits / (-std::log(fp_rate) / (ln2 * ln2));
+    double best_load = 0.0;
+    hash_count_ = k_hi;
+    for (unsigned k = k_lo; k <= k_hi; ++k)
+    {
+      double lo = 0.0;
+      double hi = max_load;
+      for (int iter = 0; iter < 24; ++iter)
+      {
+        const double mid = (lo + hi) / 2;
+        if (blocked_fp_rate(mid, k) <= fp_rate)
+          lo = mid;
+        else
+          hi = mid;
+      }
+      if (lo > best_load)
+      {
+        best_load = lo;
+        hash_count_ = k;
+      }
+    }
+    best_load = std::max(best_load, 1e-3);
+    const double keys = std::max(1.0, static_cast<double>(expected_keys));
+    block_count_ = static_cast<size_t>(std::ceil(keys / best_load));
+    block_count_ = std::max<size_t>(1, block_count_);
+    // 多分配 7 个字, 使块数组按 64 字节对齐
+    words_.assign(block_count_ * bloom_filter_view::block_words + 7, 0);
+  }
+
+  const uint64_t *blocks() const noexcept
+  {
+    const uintptr_t addr = reinterpret_cast<uintptr_t>(words_.data());
+    return words_.data() + (64 - addr % 64) % 64 / 8;
+  }
+
+  uint64_t *blocks() noexcept
+  {
+    const uintptr_t addr = reinterpret_cast<uintptr_t>(words_.data());
+    return words_.data() + (64 - addr % 64) % 64 / 8;
+  }
+
+  std::vector<uint64_t> words_;
+  size_t block_count_;
+  unsigned hash_count_;
+  size_t key_count_;
+};
+
+}  // namespace abin
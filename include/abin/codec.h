@@ -0,0 +1,234 @@
+/**************************************************************************************************************
+ *~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ * @file: codec.h
+ * @description: 基于 abin::string_view 的十六进制与 base64 编解码, 结果写入调用者提供的缓冲区.
+ * - *_encoded_size / *_decoded_size 精确计算输出长度, 按该长度分配缓冲区即可, 不会越界写入.
+ * - 解码遇到非法字符时返回其位置(codec_result::error_pos), 输出缓冲区中前 written 字节有效.
+ * - CPU 支持 SSSE3 / AVX2 时使用向量内核(运行期选择, 见 abin/dispatch.h 的 feature_slot), 否则使用标量实现.
+ * - base64 使用 RFC 4648 标准字母表; 解码同时接受带 '=' 填充与不带填充的输入, 不接受空白字符.
+ *~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ **************************************************************************************************************/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "abin/detail/codec_kernels.h"
+#include "abin/dispatch.h"
+#include "abin/string_view.h"
+
+namespace abin
+{
+
+// 解码结果
+struct codec_result {
+  size_t written;    // 写入输出缓冲区的字节数
+  size_t error_pos;  // 第一个非法字符的位置; 输入被截断时为输入长度; 成功时为 string_view::npos
+
+  bool ok() const noexcept
+  {
+    return error_pos == string_view::npos;
+  }
+  explicit operator bool() const noexcept
+  {
+    return ok();
+  }
+};
+
+enum class hex_case { lower, upper };
+
+namespace detail
+{
+
+using hex_encode_fn = size_t (*)(const unsigned char *, size_t, char *, const char *);
+using base64_encode_fn = size_t (*)(const unsigned char *, size_t, char *);
+using decode_fn = size_t (*)(const char *, size_t, unsigned char *);
+
+// 某一指令集级别下的编解码内核
+struct codec_kernel_set {
+  hex_encode_fn hex_encode;
+  decode_fn hex_decode;
+  base64_encode_fn base64_encode;
+  decode_fn base64_decode;
+};
+
+// 编解码内核依赖 pshufb, 没有 SSE2 版本: 低于 SSSE3 时使用标量实现
+inline codec_kernel_set codec_kernels_for(dispatch::isa level) noexcept
+{
+#if defined(ABIN_SV_HAS_SSE2)
+  if (level >= dispatch::isa::avx2) return {hex_encode_avx2, hex_decode_avx2, base64_encode_avx2, base64_decode_avx2};
+  if (level >= dispatch::isa::ssse3)
+  {
+    return {hex_encode_ssse3, hex_decode_ssse3, base64_encode_ssse3, base64_decode_ssse3};
+  }
+#else
+  (void)level;
+#endif
+  return {hex_encode_scalar, hex_decode_scalar, base64_encode_scalar, base64_decode_scalar};
+}
+
+inline hex_encode_fn select_hex_encode(dispatch::isa level) noexcept
+{
+  return codec_kernels_for(level).hex_encode;
+}
+inline decode_fn select_hex_decode(dispatch::isa level) noexcept
+{
+  return codec_kernels_for(level).hex_decode;
+}
+inline base64_encode_fn select_base64_encode(dispatch::isa level) noexcept
+{
+  return codec_kernels_for(level).base64_encode;
+}
+inline decode_fn select_base64_decode(dispatch::isa level) noexcept
+{
+  return codec_kernels_for(level).base64_decode;
+}
+
+// ---------- 当前绑定的内核: 不在核心分派表中, 首次使用时按 requested_isa() 绑定 ----------
+inline hex_encode_fn hex_encode_kernel() noexcept
+{
+  static dispatch::feature_slot<hex_encode_fn> slot(select_hex_encode);
+  return slot.get();
+}
+inline decode_fn hex_decode_kernel() noexcept
+{
+  static dispatch::feature_slot<decode_fn> slot(select_hex_decode);
+  return slot.get();
+}
+inline base64_encode_fn base64_encode_kernel() noexcept
+{
+  static dispatch::feature_slot<base64_encode_fn> slot(select_base64_encode);
+  return slot.get();
+}
+inline decode_fn base64_decode_kernel() noexcept
+{
+  static dispatch::feature_slot<decode_fn> slot(select_base64_decode);
+  return slot.get();
+}
+
+}  // namespace detail
+
+// ---------- hex ----------
+
+inline size_t hex_encoded_size(size_t n) noexcept
+{
+  return 2 * n;
+}
+
+// 合法输入(偶数长度)解码后的字节数
+inline size_t hex_decoded_size(string_view hex) noexcept
+{
+  return hex.size() / 2;
+}
+
+/**
+ * @brief 十六进制编码
+ * @param in 输入字节
+ * @param out 输出缓冲区, 至少 hex_encoded_size(in.size()) 字节
+ * @param letter_case 字母大小写(默认小写)
+ * @return 写出的字符数
+ */
+inline size_t hex_encode(string_view in, char *out, hex_case letter_case = hex_case::lower) noexcept
+{
+  const char *digits = (letter_case == hex_case::upper) ? "0123456789ABCDEF" : "0123456789abcdef";
+  const auto *p = reinterpret_cast<const unsigned char *>(in.data());
+  return detail::hex_encode_kernel()(p, in.size(), out, digits);
+}
+
+/**
+ * @brief 十六进制解码(大小写均可)
+ * @param in 十六进制字符串
+ * @param out 输出缓冲区, 至少 hex_decoded_size(in) 字节
+ * @return 写出的字节数与错误位置; 长度为奇数时 error_pos 为 in.size()
+ */
+inline codec_result hex_decode(string_view in, char *out) noexcept
+{
+  const size_t even = in.size() & ~static_cast<size_t>(1);
+  auto *o = reinterpret_cast<unsigned char *>(out);
+  const size_t err = detail::hex_decode_kernel()(in.data(), even, o);
+  if (err != detail::kernel_npos) return {err / 2, err};
+  if (even != in.size()) return {even / 2, in.size()};
+  return {even / 2, string_view::npos};
+}
+
+// ---------- base64 ----------
+
+inline size_t base64_encoded_size(size_t n) noexcept
+{
+  return (n + 2) / 3 * 4;
+}
+
+namespace detail
+{
+// 末尾 '=' 填充的个数(仅当长度为 4 的倍数时才视为填充)
+inline size_t base64_padding(string_view in) noexcept
+{
+  const size_t n = in.size();
+  if (n == 0 || n % 4 != 0 || in[n - 1] != '=') return 0;
+  return in[n - 2] == '=' ? 2 : 1;
+}
+}  // namespace detail
+
+// 合法输入解码后的字节数
+inline size_t base64_decoded_size(string_view in) noexcept
+{
+  const size_t len = in.size() - detail::base64_padding(in);
+  return len / 4 * 3 + (len % 4 > 1 ? len % 4 - 1 : 0);
+}
+
+/**
+ * @brief base64 编码(带 '=' 填充)
+ * @param in 输入字节
+ * @param out 输出缓冲区, 至少 base64_encoded_size(in.size()) 字节
+ * @return 写出的字符数
+ */
+inline size_t base64_encode(string_view in, char *out) noexcept
+{
+  const auto *p = reinterpret_cast<const unsigned char *>(in.data());
+  const size_t full = in.size() / 3 * 3;
+  size_t o = detail::base64_encode_kernel()(p, full, out);
+  const size_t rest = in.size() - full;
+  if (rest != 0)
+  {
+    const char *alphabet = detail::base64_alphabet();
+    const uint32_t second = (rest == 2) ? static_cast<uint32_t>(p[full + 1]) << 8 : 0;
+    const uint32_t v = (static_cast<uint32_t>(p[full]) << 16) | second;
+    out[o++] = alphabet[(v >> 18) & 0x3F];
+    out[o++] = alphabet[(v >> 12) & 0x3F];
+    out[o++] = rest == 2 ? alphabet[(v >> 6) & 0x3F] : '=';
+    out[o++] = '=';
+  }
+  return o;
+}
+
+/**
+ * @brief base64 解码
+ * @param in base64 字符串(可带或不带 '=' 填充)
+ * @param out 输出缓冲区, 至少 base64_decoded_size(in) 字节
+ * @return 写出的字节数与错误位置; 去掉填充后长度除以 4 余 1 时输入被截断, error_pos 为 in.size()
+ */
+inline codec_result base64_decode(string_view in, char *out) noexcept
+{
+  const size_t len = in.size() - detail::base64_padding(in);
+  const size_t rem = len % 4;
+  const size_t body = len - rem;
+  auto *o = reinterpret_cast<unsigned char *>(out);
+  const size_t err = detail::base64_decode_kernel()(in.data(), body, o);
+  if (err != detail::kernel_npos) return {err / 4 * 3, err};
+
+  size_t written = body / 4 * 3;
+  uint32_t v = 0;
+  for (size_t k = 0; k < rem; ++k)
+  {
+    const unsigned d = detail::base64_value(static_cast<unsigned char>(in[body + k]));
+    if (d > 63U) return {written, body + k};
+    v |= static_cast<uint32_t>(d) << (18 - 6 * k);
+  }
+  if (rem == 1) return {written, in.size()};
+  if (rem >= 2) o[written++] = static_cast<unsigned char>(v >> 16);
+  if (rem == 3) o[written++] = static_cast<unsigned char>(v >> 8);
+  return {written, string_view::npos};
+}
+
+}  // namespace abin
@@ -0,0 +1,218 @@
+/**************************************************************************************************************
+ *~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ * @file: csv.h
+ * @description: 基于 abin::string_view 的 RFC 4180 CSV 读取器, 逐条记录返回指向输入的字段.
+ * - 字段以 string_view 的形式直接引用输入, 不拷贝; 只有含双写引号("")的引号字段需要去转义,
+ *   这类字段写入读取器内部的暂存区, 在下一次 next() 之前有效.
+ * - 未加引号的字段用 find_first_of(分隔符, '\r', '\n') 一次跳过, 引号字段用 find(引号) 跳到下一个引号,
+ *   两者都走 SIMD 内核(见 abin/dispatch.h), 普通字符不逐个判断.
+ * - 记录以 "\n"、"\r\n" 或单独的 "\r" 结尾; 输入末尾的换行不产生额外的空记录, 空行是只有一个空字段的记录.
+ * - 引号字段可以包含分隔符与换行; 未加引号的字段中的引号按普通字符处理;
+ *   闭合引号后紧跟分隔符/换行以外的字符, 或引号到输入末尾仍未闭合时报告错误及其位置.
+ * - 分块输入: 构造时传入 final_chunk = false, 读到不完整的最后一条记录时 next() 返回 false 且 error() 为 none,
+ *   consumed() 给出已完整解析的字节数, 调用者把剩余部分与下一块拼接后重新构造读取器.
+ *~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ **************************************************************************************************************/
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include "abin/string_view.h"
+
+namespace abin
+{
+
+enum class csv_error {
+  none,                // 没有错误
+  unterminated_quote,  // 引号字段直到输入末尾仍未闭合
+  text_after_quote     // 闭合引号后紧跟分隔符/换行以外的字符
+};
+
+// ---------- csv_reader 类 ----------
+class csv_reader
+{
+ public:
+  /**
+   * @brief 构造读取器
+   * @param input CSV 文本, 读取期间必须保持有效
+   * @param delimiter 字段分隔符(默认 ','), 不能是引号、'\r' 或 '\n'
+   * @param quote 引号字符(默认 '"')
+   * @param final_chunk 输入是否为完整数据的最后一块; 为 false 时不返回可能被截断的最后一条记录
+   */
+  explicit csv_reader(string_view input, char delimiter = ',', char quote = '"', bool final_chunk = true) noexcept :
+    input_(input),
+    delimiter_(delimiter),
+    quote_(quote),
+    final_(final_chunk),
+    pos_(0),
+    records_(0),
+    error_(csv_error::none),
+    error_pos_(string_view::npos)
+  {
+    stops_[0] = delimiter;
+    stops_[1] = '\r';
+    stops_[2] = '\n';
+  }
+
+  /**
+   * @brief 读取下一条记录
+   * @param fields 输出字段(先清空); 字段引用输入或内部暂存区, 在下一次调用 next() 之前有效
+   * @return 读到记录返回 true; 输入结束、遇到不完整记录(final_chunk 为 false)或出错时返回 false
+   */
+  bool next(std::vector<string_view> &fields)
+  {
+    fields.clear();
+    arena_.clear();
+    fixups_.clear();
+    if (error_ != csv_error::none || pos_ >= input_.size()) return false;
+
+    const size_t n = input_.size();
+    size_t p = pos_;
+    for (;;)
+    {
+      size_t end = 0;  // 字段之后的第一个字符(分隔符、换行或 n)
+      if (p < n && input_[p] == quote_)
+      {
+        if (!read_quoted(p, fields, end)) return fail(fields);
+      }
+      else
+      {
+        end = input_.find_first_of(string_view(stops_, 3), p);
+        if (end == string_view::npos)
+        {
+          if (!final_) return fail(fields);
+          end = n;
+        }
+        fields.push_back(input_.substr(p, end - p));
+      }
+
+      if (end < n && input_[end] == delimiter_)
+      {
+        p = end + 1;
+        continue;
+      }
+      if (end == n)
+      {
+        if (!final_) return fail(fields);
+        pos_ = n;
+      }
+      else if (input_[end] == '\r' && end + 1 == n && !final_)
+      {
+        return fail(fields);  // 可能是被截断的 "\r\n"
+      }
+      else
+      {
+        pos_ = (input_[end] == '\r' && end + 1 < n && input_[end + 1] == '\n') ? end + 2 : end + 1;
+      }
+      break;
+    }
+
+    // 暂存区在记录解析完毕后才不再增长, 此时再生成指向它的字段
+    for (const fixup &f : fixups_) fields[f.field] = string_view(arena_.data() + f.offset, f.length);
+    ++records_;
+    return true;
+  }
+
+  // 已完整解析的字节数; 分块输入时, 从该位置开始的剩余部分需要与下一块拼接
+  size_t consumed() const noexcept
+  {
+    return pos_;
+  }
+
+  // 已返回的记录条数
+  size_t records() const noexcept
+  {
+    return records_;
+  }
+
+  csv_error error() const noexcept
+  {
+    return error_;
+  }
+
+  // 错误发生的位置(输入中的字节偏移), 没有错误时为 string_view::npos
+  size_t error_pos() const noexcept
+  {
+    return error_pos_;
+  }
+
+ private:
+  // 暂存区中的一个字段
+  struct fixup {
+    size_t field;
+    size_t offset;
+    size_t length;
+  };
+
+  // 解析以 input_[p] == quote_ 开头的引号字段; end 为闭合引号之后的位置
+  bool read_quoted(size_t p, std::vector<string_view> &fields, size_t &end)
+  {
+    const size_t n = input_.size();
+    const size_t offset = arena_.size();
+    size_t seg = p + 1;  // 尚未写入暂存区的片段起点
+    bool escaped = false;
+    for (;;)
+    {
+      const size_t q = input_.find(quote_, seg);
+      if (q == string_view::npos || (q + 1 == n && !final_))
+      {
+        if (final_) set_error(csv_error::unterminated_quote, p);
+        return false;
+      }
+      if (q + 1 < n && input_[q + 1] == quote_)
+      {
+        // 双写引号: 保留一个引号, 跳过另一个
+        arena_.append(input_.data() + seg, q + 1 - seg);
+        seg = q + 2;
+        escaped = true;
+        continue;
+      }
+      end = q + 1;
+      if (end < n && input_[end] != delimiter_ && input_[end] != '\r' && input_[end] != '\n')
+      {
+        set_error(csv_error::text_after_quote, end);
+        return false;
+      }
+      if (escaped)
+      {
+        arena_.append(input_.data() + seg, q - seg);
+        fixups_.push_back(fixup{fields.size(), offset, arena_.size() - offset});
+        fields.emplace_back();
+      }
+      else
+      {
+        fields.push_back(input_.substr(p + 1, q - p - 1));
+      }
+      return true;
+    }
+  }
+
+  bool fail(std::vector<string_view> &fields) noexcept
+  {
+    fields.clear();
+    return false;
+  }
+
+  void set_error(csv_error e, size_t pos) noexcept
+  {
+    error_ = e;
+    error_pos_ = pos;
+  }
+
+  string_view input_;
+  char delimiter_;
+  char quote_;
+  char stops_[3];  // 未加引号字段的结束字符
+  bool final_;
+  size_t pos_;  // 下一条记录的起点
+  size_t records_;
+  csv_error error_;
+  size_t error_pos_;
+  std::string arena_;  // 去转义后的引号字段
+  std::vector<fixup> fixups_;
+};
+
+}  // namespace abin
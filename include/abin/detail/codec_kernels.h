@@ -0,0 +1,348 @@
+/**************************************************************************************************************
+ *~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ * @file: codec_kernels.h
+ * @description: 十六进制与 base64 编解码的各指令集内核(库内部使用).
+ * - 编码内核写出全部结果, 返回写出的字符数; 解码内核返回第一个非法字符的位置, 全部合法返回 kernel_npos.
+ * - 所有向量内核只在输出缓冲区确有空间时才做整块写入, 调用方按精确大小分配即可.
+ * - hex: 半字节通过 pshufb 查表转为字符; 解码用无符号范围比较校验, pmaddubsw 合并相邻半字节.
+ * - base64: W. Muła 与 D. Lemire 的向量算法(Faster Base64 Encoding and Decoding Using AVX2 Instructions):
+ *   编码用乘法把 3 字节拆成 4 个 6 位索引, 再按区间查表加偏移; 解码用高/低半字节双表校验并求偏移,
+ *   再用 pmaddubsw / pmaddwd 把 4 个 6 位值拼回 3 字节.
+ *~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ **************************************************************************************************************/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "abin/detail/simd.h"
+#include "abin/detail/string_kernels.h"
+
+namespace abin
+{
+namespace detail
+{
+
+// ---------- scalar ----------
+
+// 十六进制字符对应的值, 非法字符返回 0xFF
+inline unsigned hex_value(unsigned char c) noexcept
+{
+  if (static_cast<unsigned>(c - '0') < 10U) return static_cast<unsigned>(c - '0');
+  const auto l = static_cast<unsigned>((c | 0x20) - 'a');
+  return l < 6U ? l + 10U : 0xFFU;
+}
+
+inline size_t hex_encode_scalar(const unsigned char *in, size_t n, char *out, const char *digits) noexcept
+{
+  for (size_t i = 0; i < n; ++i)
+  {
+    out[2 * i] = digits[in[i] >> 4];
+    out[2 * i + 1] = digits[in[i] & 0x0F];
+  }
+  return 2 * n;
+}
+
+// n 必须为偶数
+inline size_t hex_decode_scalar(const char *in, size_t n, unsigned char *out) noexcept
+{
+  for (size_t i = 0; i < n; i += 2)
+  {
+    const unsigned hi = hex_value(static_cast<unsigned char>(in[i]));
+    if (hi > 15U) return i;
+    const unsigned lo = hex_value(static_cast<unsigned char>(in[i + 1]));
+    if (lo > 15U) return i + 1;
+    out[i / 2] = static_cast<unsigned char>((hi << 4) | lo);
+  }
+  return kernel_npos;
+}
+
+// base64 标准字母表(RFC 4648 第 4 节)
+inline const char *base64_alphabet() noexcept
+{
+  return "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+}
+
+// base64 字符对应的 6 位值, 非法字符返回 0xFF
+inline unsigned base64_value(unsigned char c) noexcept
+{
+  if (c >= 'A' && c <= 'Z') return c - 'A';
+  if (c >= 'a' && c <= 'z') return c - 'a' + 26U;
+  if (c >= '0' && c <= '9') return c - '0' + 52U;
+  if (c == '+') return 62U;
+  if (c == '/') return 63U;
+  return 0xFFU;
+}
+
+// 只编码完整的 3 字节组, n 必须为 3 的倍数
+inline size_t base64_encode_scalar(const unsigned char *in, size_t n, char *out) noexcept
+{
+  const char *alphabet = base64_alphabet();
+  size_t o = 0;
+  for (size_t i = 0; i + 3 <= n; i += 3)
+  {
+    const uint32_t v = (static_cast<uint32_t>(in[i]) << 16) | (static_cast<uint32_t>(in[i + 1]) << 8) | in[i + 2];
+    out[o++] = alphabet[(v >> 18) & 0x3F];
+    out[o++] = alphabet[(v >> 12) & 0x3F];
+    out[o++] = alphabet[(v >> 6) & 0x3F];
+    out[o++] = alphabet[v & 0x3F];
+  }
+  return o;
+}
+
+// 只解码完整的 4 字符组(不含 '='), n 必须为 4 的倍数
+inline size_t base64_decode_scalar(const char *in, size_t n, unsigned char *out) noexcept
+{
+  for (size_t i = 0; i < n; i += 4)
+  {
+    uint32_t v = 0;
+    for (size_t k = 0; k < 4; ++k)
+    {
+      const unsigned d = base64_value(static_cast<unsigned char>(in[i + k]));
+      if (d > 63U) return i + k;
+      v = (v << 6) | d;
+    }
+    out[i / 4 * 3] = static_cast<unsigned char>(v >> 16);
+    out[i / 4 * 3 + 1] = static_cast<unsigned char>(v >> 8);
+    out[i / 4 * 3 + 2] = static_cast<unsigned char>(v);
+  }
+  return kernel_npos;
+}
+
+#if defined(ABIN_SV_HAS_SSE2)
+// ---------- ssse3 ----------
+
+ABIN_SV_TARGET_SSSE3 inline size_t hex_encode_ssse3(const unsigned char *in, size_t n, char *out,
+                                                    const char *digits) noexcept
+{
+  const __m128i table = _mm_loadu_si128(reinterpret_cast<const __m128i *>(digits));
+  const __m128i nibble = _mm_set1_epi8(0x0F);
+  size_t i = 0;
+  for (; i + 16 <= n; i += 16)
+  {
+    const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(in + i));
+    const __m128i hi = _mm_shuffle_epi8(table, _mm_and_si128(_mm_srli_epi16(v, 4), nibble));
+    const __m128i lo = _mm_shuffle_epi8(table, _mm_and_si128(v, nibble));
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(out + 2 * i), _mm_unpacklo_epi8(hi, lo));
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(out + 2 * i + 16), _mm_unpackhi_epi8(hi, lo));
+  }
+  hex_encode_scalar(in + i, n - i, out + 2 * i, digits);
+  return 2 * n;
+}
+
+// 把 16 个十六进制字符转换为半字节值; 全部合法时返回 true
+ABIN_SV_TARGET_SSSE3 inline bool hex_nibbles_ssse3(__m128i v, __m128i &values) noexcept
+{
+  const __m128i d = _mm_sub_epi8(v, _mm_set1_epi8('0'));
+  const __m128i is_digit = _mm_cmpeq_epi8(_mm_min_epu8(d, _mm_set1_epi8(9)), d);
+  const __m128i l = _mm_sub_epi8(_mm_or_si128(v, _mm_set1_epi8(0x20)), _mm_set1_epi8('a'));
+  const __m128i is_alpha = _mm_cmpeq_epi8(_mm_min_epu8(l, _mm_set1_epi8(5)), l);
+  values = _mm_or_si128(_mm_and_si128(is_digit, d), _mm_and_si128(is_alpha, _mm_add_epi8(l, _mm_set1_epi8(10))));
+  return _mm_movemask_epi8(_mm_or_si128(is_digit, is_alpha)) == 0xFFFF;
+}
+
+ABIN_SV_TARGET_SSSE3 inline size_t hex_decode_ssse3(const char *in, size_t n, unsigned char *out) noexcept
+{
+  const __m128i weights = _mm_set1_epi16(0x0110);  // 偶数位置 * 16 + 奇数位置 * 1
+  size_t i = 0;
+  for (; i + 16 <= n; i += 16)
+  {
+    __m128i values;
+    if (!hex_nibbles_ssse3(_mm_loadu_si128(reinterpret_cast<const __m128i *>(in + i)), values)) break;
+    const __m128i bytes = _mm_maddubs_epi16(values, weights);
+    _mm_storel_epi64(reinterpret_cast<__m128i *>(out + i / 2), _mm_packus_epi16(bytes, bytes));
+  }
+  const size_t rest = hex_decode_scalar(in + i, n - i, out + i / 2);
+  return rest != kernel_npos ? i + rest : kernel_npos;
+}
+
+// 12 字节 -> 16 个 6 位索引(每个占一个字节)
+ABIN_SV_TARGET_SSSE3 inline __m128i base64_split_ssse3(__m128i in) noexcept
+{
+  in = _mm_shuffle_epi8(in, _mm_setr_epi8(1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10));
+  const __m128i t0 = _mm_and_si128(in, _mm_set1_epi32(0x0FC0FC00));
+  const __m128i t1 = _mm_mulhi_epu16(t0, _mm_set1_epi32(0x04000040));
+  const __m128i t2 = _mm_and_si128(in, _mm_set1_epi32(0x003F03F0));
+  const __m128i t3 = _mm_mullo_epi16(t2, _mm_set1_epi32(0x01000010));
+  return _mm_or_si128(t1, t3);
+}
+
+// 6 位索引 -> base64 字符: 按区间选出偏移量再相加
+ABIN_SV_TARGET_SSSE3 inline __m128i base64_lookup_ssse3(__m128i indices) noexcept
+{
+  __m128i r = _mm_subs_epu8(indices, _mm_set1_epi8(51));
+  const __m128i less = _mm_cmpgt_epi8(_mm_set1_epi8(26), indices);
+  r = _mm_or_si128(r, _mm_and_si128(less, _mm_set1_epi8(13)));
+  const __m128i shift = _mm_setr_epi8('a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+                                      '0' - 52, '0' - 52, '0' - 52, '+' - 62, '/' - 63, 'A', 0, 0);
+  return _mm_add_epi8(_mm_shuffle_epi8(shift, r), indices);
+}
+
+ABIN_SV_TARGET_SSSE3 inline size_t base64_encode_ssse3(const unsigned char *in, size_t n, char *out) noexcept
+{
+  size_t i = 0;
+  size_t o = 0;
+  for (; i + 16 <= n; i += 12, o += 16)  // 读 16 字节, 使用其中 12 字节
+  {
+    const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(in + i));
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(out + o), base64_lookup_ssse3(base64_split_ssse3(v)));
+  }
+  return o + base64_encode_scalar(in + i, n - i, out + o);
+}
+
+// 16 个 base64 字符 -> 6 位值; 全部合法时返回 true
+ABIN_SV_TARGET_SSSE3 inline bool base64_values_ssse3(__m128i v, __m128i &values) noexcept
+{
+  const __m128i lut_lo = _mm_setr_epi8(0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x13, 0x1A, 0x1B,
+                                       0x1B, 0x1B, 0x1A);
+  const __m128i lut_hi = _mm_setr_epi8(0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08, 0x10, 0x10, 0x10, 0x10, 0x10,
+                                       0x10, 0x10, 0x10);
+  const __m128i lut_roll = _mm_setr_epi8(0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0);
+  const __m128i nibble = _mm_set1_epi8(0x0F);
+  const __m128i hi_nibbles = _mm_and_si128(_mm_srli_epi32(v, 4), nibble);
+  const __m128i lo = _mm_shuffle_epi8(lut_lo, _mm_and_si128(v, nibble));
+  const __m128i hi = _mm_shuffle_epi8(lut_hi, hi_nibbles);
+  const __m128i bad = _mm_cmpeq_epi8(_mm_and_si128(lo, hi), _mm_setzero_si128());
+  if (_mm_movemask_epi8(bad) != 0xFFFF) return false;
+  const __m128i eq_slash = _mm_cmpeq_epi8(v, _mm_set1_epi8('/'));
+  values = _mm_add_epi8(v, _mm_shuffle_epi8(lut_roll, _mm_add_epi8(eq_slash, hi_nibbles)));
+  return true;
+}
+
+// 16 个 6 位值 -> 12 字节(位于结果的低 12 字节)
+ABIN_SV_TARGET_SSSE3 inline __m128i base64_pack_ssse3(__m128i values) noexcept
+{
+  const __m128i ab_bc = _mm_maddubs_epi16(values, _mm_set1_epi32(0x01400140));
+  const __m128i abc = _mm_madd_epi16(ab_bc, _mm_set1_epi32(0x00011000));
+  return _mm_shuffle_epi8(abc, _mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1));
+}
+
+ABIN_SV_TARGET_SSSE3 inline size_t base64_decode_ssse3(const char *in, size_t n, unsigned char *out) noexcept
+{
+  size_t i = 0;
+  // 每次写 16 字节(有效 12 字节), 保证剩余输出空间不少于 16 字节
+  for (; i + 24 <= n; i += 16)
+  {
+    __m128i values;
+    if (!base64_values_ssse3(_mm_loadu_si128(reinterpret_cast<const __m128i *>(in + i)), values)) break;
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(out + i / 4 * 3), base64_pack_ssse3(values));
+  }
+  const size_t rest = base64_decode_scalar(in + i, n - i, out + i / 4 * 3);
+  return rest != kernel_npos ? i + rest : kernel_npos;
+}
+
+// ---------- avx2 ----------
+
+ABIN_SV_TARGET_AVX2 inline size_t hex_encode_avx2(const unsigned char *in, size_t n, char *out,
+                                                  const char *digits) noexcept
+{
+  const __m256i table = _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i *>(digits)));
+  const __m256i nibble = _mm256_set1_epi8(0x0F);
+  size_t i = 0;
+  for (; i + 32 <= n; i += 32)
+  {
+    const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(in + i));
+    const __m256i hi = _mm256_shuffle_epi8(table, _mm256_and_si256(_mm256_srli_epi16(v, 4), nibble));
+    const __m256i lo = _mm256_shuffle_epi8(table, _mm256_and_si256(v, nibble));
+    // unpack 在每个 128 位通道内进行, 需要重新排列通道
+    const __m256i a = _mm256_unpacklo_epi8(hi, lo);
+    const __m256i b = _mm256_unpackhi_epi8(hi, lo);
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(out + 2 * i), _mm256_permute2x128_si256(a, b, 0x20));
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(out + 2 * i + 32), _mm256_permute2x128_si256(a, b, 0x31));
+  }
+  hex_encode_ssse3(in + i, n - i, out + 2 * i, digits);
+  return 2 * n;
+}
+
+ABIN_SV_TARGET_AVX2 inline size_t hex_decode_avx2(const char *in, size_t n, unsigned char *out) noexcept
+{
+  const __m256i weights = _mm256_set1_epi16(0x0110);
+  size_t i = 0;
+  for (; i + 32 <= n; i += 32)
+  {
+    const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(in + i));
+    const __m256i d = _mm256_sub_epi8(v, _mm256_set1_epi8('0'));
+    const __m256i is_digit = _mm256_cmpeq_epi8(_mm256_min_epu8(d, _mm256_set1_epi8(9)), d);
+    const __m256i l = _mm256_sub_epi8(_mm256_or_si256(v, _mm256_set1_epi8(0x20)), _mm256_set1_epi8('a'));
+    const __m256i is_alpha = _mm256_cmpeq_epi8(_mm256_min_epu8(l, _mm256_set1_epi8(5)), l);
+    if (_mm256_movemask_epi8(_mm256_or_si256(is_digit, is_alpha)) != -1) break;
+    const __m256i values = _mm256_or_si256(_mm256_and_si256(is_digit, d),
+                                           _mm256_and_si256(is_alpha, _mm256_add_epi8(l, _mm256_set1_epi8(10))));
+    const __m256i bytes = _mm256_maddubs_epi16(values, weights);
+    // packus 在通道内进行: 每个通道的低 8 字节有效, 再把两个通道的低 64 位拼到一起
+    const __m256i packed = _mm256_permute4x64_epi64(_mm256_packus_epi16(bytes, bytes), 0x08);
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(out + i / 2), _mm256_castsi256_si128(packed));
+  }
+  const size_t rest = hex_decode_ssse3(in + i, n - i, out + i / 2);
+  return rest != kernel_npos ? i + rest : kernel_npos;
+}
+
+ABIN_SV_TARGET_AVX2 inline size_t base64_encode_avx2(const unsigned char *in, size_t n, char *out) noexcept
+{
+  const __m256i split_shuffle = _mm256_setr_epi8(1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10, 1, 0, 2, 1, 4, 3,
+                                                 5, 4, 7, 6, 8, 7, 10, 9, 11, 10);
+  const __m256i shift = _mm256_setr_epi8('a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+                                         '0' - 52, '0' - 52, '0' - 52, '0' - 52, '+' - 62, '/' - 63, 'A', 0, 0,
+                                         'a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+                                         '0' - 52, '0' - 52, '0' - 52, '0' - 52, '+' - 62, '/' - 63, 'A', 0, 0);
+  size_t i = 0;
+  size_t o = 0;
+  for (; i + 28 <= n; i += 24, o += 32)  // 两个通道各处理 12 字节
+  {
+    const __m128i lo_half = _mm_loadu_si128(reinterpret_cast<const __m128i *>(in + i));
+    const __m128i hi_half = _mm_loadu_si128(reinterpret_cast<const __m128i *>(in + i + 12));
+    __m256i v = _mm256_inserti128_si256(_mm256_castsi128_si256(lo_half), hi_half, 1);
+    v = _mm256_shuffle_epi8(v, split_shuffle);
+    const __m256i t0 = _mm256_and_si256(v, _mm256_set1_epi32(0x0FC0FC00));
+    const __m256i t1 = _mm256_mulhi_epu16(t0, _mm256_set1_epi32(0x04000040));
+    const __m256i t2 = _mm256_and_si256(v, _mm256_set1_epi32(0x003F03F0));
+    const __m256i t3 = _mm256_mullo_epi16(t2, _mm256_set1_epi32(0x01000010));
+    const __m256i indices = _mm256_or_si256(t1, t3);
+    __m256i r = _mm256_subs_epu8(indices, _mm256_set1_epi8(51));
+    const __m256i less = _mm256_cmpgt_epi8(_mm256_set1_epi8(26), indices);
+    r = _mm256_or_si256(r, _mm256_and_si256(less, _mm256_set1_epi8(13)));
+    r = _mm256_add_epi8(_mm256_shuffle_epi8(shift, r), indices);
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(out + o), r);
+  }
+  return o + base64_encode_ssse3(in + i, n - i, out + o);
+}
+
+ABIN_SV_TARGET_AVX2 inline size_t base64_decode_avx2(const char *in, size_t n, unsigned char *out) noexcept
+{
+  const __m256i lut_lo = _mm256_setr_epi8(0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x13, 0x1A,
+                                          0x1B, 0x1B, 0x1B, 0x1A, 0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11,
+                                          0x11, 0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A);
+  const __m256i lut_hi = _mm256_setr_epi8(0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08, 0x10, 0x10, 0x10, 0x10,
+                                          0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08,
+                                          0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10);
+  const __m256i lut_roll = _mm256_setr_epi8(0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0, 0, 16, 19, 4,
+                                            -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0);
+  const __m256i pack_shuffle = _mm256_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1, 2, 1, 0, 6,
+                                                5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1);
+  const __m256i nibble = _mm256_set1_epi8(0x0F);
+  size_t i = 0;
+  // 每次写 32 字节(有效 24 字节), 保证剩余输出空间不少于 32 字节
+  for (; i + 44 <= n; i += 32)
+  {
+    const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(in + i));
+    const __m256i hi_nibbles = _mm256_and_si256(_mm256_srli_epi32(v, 4), nibble);
+    const __m256i lo = _mm256_shuffle_epi8(lut_lo, _mm256_and_si256(v, nibble));
+    const __m256i hi = _mm256_shuffle_epi8(lut_hi, hi_nibbles);
+    if (_mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_and_si256(lo, hi), _mm256_setzero_si256())) != -1) break;
+    const __m256i eq_slash = _mm256_cmpeq_epi8(v, _mm256_set1_epi8('/'));
+    const __m256i values = _mm256_add_epi8(v, _mm256_shuffle_epi8(lut_roll, _mm256_add_epi8(eq_slash, hi_nibbles)));
+    const __m256i ab_bc = _mm256_maddubs_epi16(values, _mm256_set1_epi32(0x01400140));
+    const __m256i abc = _mm256_madd_epi16(ab_bc, _mm256_set1_epi32(0x00011000));
+    const __m256i lanes = _mm256_shuffle_epi8(abc, pack_shuffle);
+    // 每个通道低 12 字节有效, 用 32 位粒度的跨通道重排拼接成连续的 24 字节
+    const __m256i packed = _mm256_permutevar8x32_epi32(lanes, _mm256_setr_epi32(0, 1, 2, 4, 5, 6, 3, 7));
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(out + i / 4 * 3), packed);
+  }
+  const size_t rest = base64_decode_ssse3(in + i, n - i, out + i / 4 * 3);
+  return rest != kernel_npos ? i + rest : kernel_npos;
+}
+#endif
+
+}  // namespace detail
+}  // namespace abin
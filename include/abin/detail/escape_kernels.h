@@ -0,0 +1,110 @@
+/**************************************************************************************************************
+ *~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ * @file: escape_kernels.h
+ * @description: 字符串转义使用的"需要转义的字符"查找内核(库内部使用).
+ * - find_escape(s, n, extra) 返回第一个控制字符(< 0x20)、'"'、'\\' 或等于 extra 的字节的位置,
+ *   找不到返回 kernel_npos. JSON 传入 '"'(不增加字符), C 风格传入 0x7F(DEL).
+ * - 向量内核对每块做三次 cmpeq 与一次无符号 max(v, 0x1F) == 0x1F 判断控制字符, 合并后只做一次分支.
+ *~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ **************************************************************************************************************/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "abin/detail/simd.h"
+#include "abin/detail/string_kernels.h"
+
+namespace abin
+{
+namespace detail
+{
+
+// ---------- scalar ----------
+
+inline bool needs_escape(unsigned char c, unsigned char extra) noexcept
+{
+  return c < 0x20 || c == '"' || c == '\\' || c == extra;
+}
+
+inline size_t find_escape_scalar(const char *s, size_t n, char extra) noexcept
+{
+  const auto x = static_cast<unsigned char>(extra);
+  for (size_t i = 0; i < n; ++i)
+  {
+    if (needs_escape(static_cast<unsigned char>(s[i]), x)) return i;
+  }
+  return kernel_npos;
+}
+
+#if defined(ABIN_SV_HAS_SSE2)
+
+// ---------- SSE2 ----------
+
+inline __m128i escape_mask_sse2(__m128i v, __m128i quote, __m128i backslash, __m128i extra, __m128i ctrl) noexcept
+{
+  const __m128i special = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(v, quote), _mm_cmpeq_epi8(v, backslash)),
+                                       _mm_cmpeq_epi8(v, extra));
+  return _mm_or_si128(special, _mm_cmpeq_epi8(_mm_max_epu8(v, ctrl), ctrl));
+}
+
+inline size_t find_escape_sse2(const char *s, size_t n, char extra) noexcept
+{
+  const __m128i quote = _mm_set1_epi8('"');
+  const __m128i backslash = _mm_set1_epi8('\\');
+  const __m128i x = _mm_set1_epi8(extra);
+  const __m128i ctrl = _mm_set1_epi8(0x1F);
+  size_t i = 0;
+  // 每轮处理 32 字节, 合并 2 个掩码后只做一次分支判断
+  for (; i + 32 <= n; i += 32)
+  {
+    const __m128i m0 = escape_mask_sse2(_mm_loadu_si128(reinterpret_cast<const __m128i *>(s + i)), quote, backslash,
+                                        x, ctrl);
+    const __m128i m1 = escape_mask_sse2(_mm_loadu_si128(reinterpret_cast<const __m128i *>(s + i + 16)), quote,
+                                        backslash, x, ctrl);
+    if (_mm_movemask_epi8(_mm_or_si128(m0, m1)) != 0)
+    {
+      const uint32_t mask = static_cast<uint32_t>(_mm_movemask_epi8(m0)) |
+                            (static_cast<uint32_t>(_mm_movemask_epi8(m1)) << 16);
+      return i + ctz32(mask);
+    }
+  }
+  for (; i + 16 <= n; i += 16)
+  {
+    const __m128i m = escape_mask_sse2(_mm_loadu_si128(reinterpret_cast<const __m128i *>(s + i)), quote, backslash,
+                                       x, ctrl);
+    const int mask = _mm_movemask_epi8(m);
+    if (mask != 0) return i + ctz32(static_cast<uint32_t>(mask));
+  }
+  const size_t r = find_escape_scalar(s + i, n - i, extra);
+  return r == kernel_npos ? kernel_npos : i + r;
+}
+
+// ---------- AVX2 ----------
+
+ABIN_SV_TARGET_AVX2 inline size_t find_escape_avx2(const char *s, size_t n, char extra) noexcept
+{
+  const __m256i quote = _mm256_set1_epi8('"');
+  const __m256i backslash = _mm256_set1_epi8('\\');
+  const __m256i x = _mm256_set1_epi8(extra);
+  const __m256i ctrl = _mm256_set1_epi8(0x1F);
+  size_t i = 0;
+  for (; i + 32 <= n; i += 32)
+  {
+    const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(s + i));
+    const __m256i special =
+      _mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi8(v, quote), _mm256_cmpeq_epi8(v, backslash)),
+                      _mm256_cmpeq_epi8(v, x));
+    const __m256i m = _mm256_or_si256(special, _mm256_cmpeq_epi8(_mm256_max_epu8(v, ctrl), ctrl));
+    const auto mask = static_cast<uint32_t>(_mm256_movemask_epi8(m));
+    if (mask != 0) return i + ctz32(mask);
+  }
+  const size_t r = find_escape_sse2(s + i, n - i, extra);
+  return r == kernel_npos ? kernel_npos : i + r;
+}
+
+#endif
+
+}  // namespace detail
+}  // namespace abin
@@ -0,0 +1,119 @@
+/**************************************************************************************************************
+ *~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ * @file: simd.h
+ * @description: abin::string_view 内部使用的 SIMD 基础设施(指令集探测宏与位运算小工具).
+ * - 仅供库内部使用, 接口不保证稳定.
+ * - 指令集宏:
+ *   - ABIN_SV_X86      : 目标平台为 x86/x86-64, 可以编译 SSE2/SSSE3/AVX2 内核(运行期再按 CPU 能力选择,
+ *                        见 abin/dispatch.h)
+ *   - ABIN_SV_HAS_SSE2 : 编译期即可无条件使用 SSE2(x86-64 基线, MSVC 的 _M_X64 / _M_IX86_FP >= 2)
+ * - ABIN_SV_TARGET_SSSE3 / ABIN_SV_TARGET_AVX2 标记只在对应内核中启用的指令集,
+ *   使这些函数无需全局 -mssse3 / -mavx2 也能编译; MSVC 无需标记.
+ * - 定义 ABIN_STRING_VIEW_NO_SIMD 可强制使用纯标量实现.
+ *~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ **************************************************************************************************************/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#if !defined(ABIN_STRING_VIEW_NO_SIMD)
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#define ABIN_SV_X86 1
+#include <immintrin.h>
+#endif
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define ABIN_SV_HAS_SSE2 1
+#endif
+#endif
+
+#if defined(__GNUC__) || defined(__clang__)
+#define ABIN_SV_TARGET_SSSE3 __attribute__((target("ssse3")))
+#define ABIN_SV_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define ABIN_SV_TARGET_SSSE3
+#define ABIN_SV_TARGET_AVX2
+#endif
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+
+namespace abin
+{
+namespace detail
+{
+
+// 统计 32 位整数中置位的个数
+inline int popcount32(uint32_t x) noexcept
+{
+#if defined(__GNUC__) || defined(__clang__)
+  return __builtin_popcount(x);
+#else
+  x = x - ((x >> 1) & 0x55555555U);
+  x = (x & 0x33333333U) + ((x >> 2) & 0x33333333U);
+  x = (x + (x >> 4)) & 0x0F0F0F0FU;
+  return static_cast<int>((x * 0x01010101U) >> 24);
+#endif
+}
+
+// 返回最低置位的下标, x 必须非 0
+inline int ctz32(uint32_t x) noexcept
+{
+#if defined(__GNUC__) || defined(__clang__)
+  return __builtin_ctz(x);
+#elif defined(_MSC_VER)
+  unsigned long idx = 0;
+  _BitScanForward(&idx, x);
+  return static_cast<int>(idx);
+#else
+  int n = 0;
+  while ((x & 1U) == 0)
+  {
+    x >>= 1;
+    ++n;
+  }
+  return n;
+#endif
+}
+
+// 返回最高置位的下标, x 必须非 0
+inline int bsr32(uint32_t x) noexcept
+{
+#if defined(__GNUC__) || defined(__clang__)
+  return 31 - __builtin_clz(x);
+#elif defined(_MSC_VER)
+  unsigned long idx = 0;
+  _BitScanReverse(&idx, x);
+  return static_cast<int>(idx);
+#else
+  int n = 0;
+  while (x >>= 1) ++n;
+  return n;
+#endif
+}
+
+// 以未对齐方式读取 8 字节(memcpy 会被编译器优化为单条 load 指令)
+inline uint64_t load_u64(const void *p) noexcept
+{
+  uint64_t v = 0;
+  std::memcpy(&v, p, sizeof(v));
+  return v;
+}
+
+// 提示 CPU 把 p 所在的缓存行预取到缓存(只读); 不支持时为空操作
+inline void prefetch(const void *p) noexcept
+{
+#if defined(__GNUC__) || defined(__clang__)
+  __builtin_prefetch(p, 0, 3);
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+  _mm_prefetch(static_cast<const char *>(p), _MM_HINT_T0);
+#else
+  (void)p;
+#endif
+}
+
+}  // namespace detail
+}  // namespace abin
@@ -0,0 +1,520 @@
+/**************************************************************************************************************
+ *~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ * @file: string_kernels.h
+ * @description: string_view 查找算法的各指令集内核(库内部使用).
+ * - 所有内核都工作在裸指针 + 长度上, 返回相对起始位置的偏移, 找不到返回 kernel_npos.
+ * - 每个算法提供 scalar / sse2 / avx2 三个版本, 由 abin/dispatch.h 在运行期绑定.
+ * - 16/32 位代码单元(char16_t / char32_t / wchar_t)的内核以模板实现, 参数为无类型指针,
+ *   标量路径通过 memcpy 读取代码单元以避免违反严格别名规则.
+ * - find 使用 "首尾字符过滤" 算法(W. Muła, SIMD-friendly algorithms for substring searching):
+ *   先并行比较候选位置的首字符与末字符, 只对两者都相等的位置做完整比较.
+ *~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ **************************************************************************************************************/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include "abin/detail/simd.h"
+
+namespace abin
+{
+namespace detail
+{
+
+enum : size_t { kernel_npos = static_cast<size_t>(-1) };
+
+// ---------- scalar ----------
+
+inline size_t find_char_scalar(const char *s, size_t n, char c) noexcept
+{
+  if (n == 0) return kernel_npos;
+  const void *p = std::memchr(s, c, n);
+  return p != nullptr ? static_cast<size_t>(static_cast<const char *>(p) - s) : kernel_npos;
+}
+
+inline size_t rfind_char_scalar(const char *s, size_t n, char c) noexcept
+{
+  for (size_t i = n; i-- > 0;)
+  {
+    if (s[i] == c) return i;
+  }
+  return kernel_npos;
+}
+
+inline size_t find_scalar(const char *s, size_t n, const char *needle, size_t m) noexcept
+{
+  if (m == 0) return 0;
+  if (m > n) return kernel_npos;
+  // 用 memchr 跳到首字符的下一个出现位置, 再比较剩余部分
+  const char first = needle[0];
+  const size_t last_start = n - m;
+  size_t i = 0;
+  while (i <= last_start)
+  {
+    const size_t hit = find_char_scalar(s + i, last_start - i + 1, first);
+    if (hit == kernel_npos) return kernel_npos;
+    i += hit;
+    if (std::memcmp(s + i + 1, needle + 1, m - 1) == 0) return i;
+    ++i;
+  }
+  return kernel_npos;
+}
+
+// 256 位字符集合, 用于 find_first_of 的常数时间成员判断
+struct char_bitmap {
+  uint64_t bits[4] = {0, 0, 0, 0};
+
+  char_bitmap(const char *set, size_t k) noexcept
+  {
+    for (size_t i = 0; i < k; ++i)
+    {
+      const auto c = static_cast<unsigned char>(set[i]);
+      bits[c >> 6] |= uint64_t{1} << (c & 63);
+    }
+  }
+
+  bool test(char ch) const noexcept
+  {
+    const auto c = static_cast<unsigned char>(ch);
+    return ((bits[c >> 6] >> (c & 63)) & 1) != 0;
+  }
+};
+
+inline size_t find_first_of_scalar(const char *s, size_t n, const char *set, size_t k) noexcept
+{
+  if (k == 0) return kernel_npos;
+  if (k == 1) return find_char_scalar(s, n, set[0]);
+  const char_bitmap bitmap(set, k);
+  for (size_t i = 0; i < n; ++i)
+  {
+    if (bitmap.test(s[i])) return i;
+  }
+  return kernel_npos;
+}
+
+// 读取第 i 个代码单元
+template <typename U>
+inline U load_unit(const void *p, size_t i) noexcept
+{
+  U v;
+  std::memcpy(&v, static_cast<const unsigned char *>(p) + i * sizeof(U), sizeof(U));
+  return v;
+}
+
+template <typename U>
+inline size_t find_unit_scalar(const void *s, size_t n, uint32_t c) noexcept
+{
+  for (size_t i = 0; i < n; ++i)
+  {
+    if (load_unit<U>(s, i) == static_cast<U>(c)) return i;
+  }
+  return kernel_npos;
+}
+
+template <typename U>
+inline size_t find_units_scalar(const void *s, size_t n, const void *needle, size_t m) noexcept
+{
+  if (m == 0) return 0;
+  if (m > n) return kernel_npos;
+  const auto *p = static_cast<const unsigned char *>(s);
+  const U first = load_unit<U>(needle, 0);
+  for (size_t i = 0; i + m <= n; ++i)
+  {
+    if (load_unit<U>(s, i) == first && std::memcmp(p + i * sizeof(U), needle, m * sizeof(U)) == 0) return i;
+  }
+  return kernel_npos;
+}
+
+// 返回第一个不相等字节的下标, 全部相等返回 n
+inline size_t mismatch_scalar(const void *a, const void *b, size_t n) noexcept
+{
+  const auto *pa = static_cast<const unsigned char *>(a);
+  const auto *pb = static_cast<const unsigned char *>(b);
+  size_t i = 0;
+  while (i + 8 <= n && load_u64(pa + i) == load_u64(pb + i)) i += 8;
+  while (i < n && pa[i] == pb[i]) ++i;
+  return i;
+}
+
+#if defined(ABIN_SV_HAS_SSE2)
+// ---------- sse2 ----------
+
+inline size_t find_char_sse2(const char *s, size_t n, char c) noexcept
+{
+  const __m128i v = _mm_set1_epi8(c);
+  size_t i = 0;
+  // 每轮处理 64 字节, 合并 4 个掩码后只做一次分支判断
+  for (; i + 64 <= n; i += 64)
+  {
+    const __m128i e0 = _mm_cmpeq_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i *>(s + i)), v);
+    const __m128i e1 = _mm_cmpeq_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i *>(s + i + 16)), v);
+    const __m128i e2 = _mm_cmpeq_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i *>(s + i + 32)), v);
+    const __m128i e3 = _mm_cmpeq_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i *>(s + i + 48)), v);
+    if (_mm_movemask_epi8(_mm_or_si128(_mm_or_si128(e0, e1), _mm_or_si128(e2, e3))) != 0)
+    {
+      const uint64_t mask = static_cast<uint64_t>(static_cast<uint32_t>(_mm_movemask_epi8(e0))) |
+                            (static_cast<uint64_t>(static_cast<uint32_t>(_mm_movemask_epi8(e1))) << 16) |
+                            (static_cast<uint64_t>(static_cast<uint32_t>(_mm_movemask_epi8(e2))) << 32) |
+                            (static_cast<uint64_t>(static_cast<uint32_t>(_mm_movemask_epi8(e3))) << 48);
+      const auto lo = static_cast<uint32_t>(mask);
+      return i + static_cast<size_t>(lo != 0 ? ctz32(lo) : 32 + ctz32(static_cast<uint32_t>(mask >> 32)));
+    }
+  }
+  for (; i + 16 <= n; i += 16)
+  {
+    const __m128i eq = _mm_cmpeq_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i *>(s + i)), v);
+    const auto mask = static_cast<uint32_t>(_mm_movemask_epi8(eq));
+    if (mask != 0) return i + static_cast<size_t>(ctz32(mask));
+  }
+  for (; i < n; ++i)
+  {
+    if (s[i] == c) return i;
+  }
+  return kernel_npos;
+}
+
+inline size_t rfind_char_sse2(const char *s, size_t n, char c) noexcept
+{
+  const __m128i v = _mm_set1_epi8(c);
+  size_t i = n;
+  for (; i >= 16; i -= 16)
+  {
+    const __m128i eq = _mm_cmpeq_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i *>(s + i - 16)), v);
+    const auto mask = static_cast<uint32_t>(_mm_movemask_epi8(eq));
+    if (mask != 0) return i - 16 + static_cast<size_t>(bsr32(mask));
+  }
+  return rfind_char_scalar(s, i, c);
+}
+
+inline size_t find_sse2(const char *s, size_t n, const char *needle, size_t m) noexcept
+{
+  if (m == 0) return 0;
+  if (m > n) return kernel_npos;
+  if (m == 1) return find_char_sse2(s, n, needle[0]);
+
+  const __m128i first = _mm_set1_epi8(needle[0]);
+  const __m128i last = _mm_set1_epi8(needle[m - 1]);
+  size_t i = 0;
+  for (; i + m - 1 + 16 <= n; i += 16)
+  {
+    const __m128i block_first = _mm_loadu_si128(reinterpret_cast<const __m128i *>(s + i));
+    const __m128i block_last = _mm_loadu_si128(reinterpret_cast<const __m128i *>(s + i + m - 1));
+    auto mask = static_cast<uint32_t>(
+      _mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi8(block_first, first), _mm_cmpeq_epi8(block_last, last))));
+    while (mask != 0)
+    {
+      const auto bit = static_cast<size_t>(ctz32(mask));
+      if (std::memcmp(s + i + bit + 1, needle + 1, m - 2) == 0) return i + bit;
+      mask &= mask - 1;
+    }
+  }
+  const size_t rest = find_scalar(s + i, n - i, needle, m);
+  return rest != kernel_npos ? i + rest : kernel_npos;
+}
+
+inline size_t find_first_of_sse2(const char *s, size_t n, const char *set, size_t k) noexcept
+{
+  // 集合较大时逐个比较不再划算, 使用位图
+  if (k == 0 || k > 16) return find_first_of_scalar(s, n, set, k);
+  if (k == 1) return find_char_sse2(s, n, set[0]);
+
+  __m128i needles[16];
+  for (size_t j = 0; j < k; ++j) needles[j] = _mm_set1_epi8(set[j]);
+  size_t i = 0;
+  for (; i + 16 <= n; i += 16)
+  {
+    const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i *>(s + i));
+    __m128i eq = _mm_cmpeq_epi8(block, needles[0]);
+    for (size_t j = 1; j < k; ++j) eq = _mm_or_si128(eq, _mm_cmpeq_epi8(block, needles[j]));
+    const auto mask = static_cast<uint32_t>(_mm_movemask_epi8(eq));
+    if (mask != 0) return i + static_cast<size_t>(ctz32(mask));
+  }
+  const size_t rest = find_first_of_scalar(s + i, n - i, set, k);
+  return rest != kernel_npos ? i + rest : kernel_npos;
+}
+
+// ---------- sse2: 16/32 位代码单元 ----------
+
+template <size_t W>
+struct unit_ops_sse2;
+
+template <>
+struct unit_ops_sse2<2> {
+  static __m128i set1(uint32_t c) noexcept
+  {
+    return _mm_set1_epi16(static_cast<short>(c));
+  }
+  static __m128i cmpeq(__m128i a, __m128i b) noexcept
+  {
+    return _mm_cmpeq_epi16(a, b);
+  }
+  // movemask 中每个代码单元对应 W 个位, 只保留最低位
+  enum : uint32_t { lane_bits = 0x5555U };
+};
+
+template <>
+struct unit_ops_sse2<4> {
+  static __m128i set1(uint32_t c) noexcept
+  {
+    return _mm_set1_epi32(static_cast<int>(c));
+  }
+  static __m128i cmpeq(__m128i a, __m128i b) noexcept
+  {
+    return _mm_cmpeq_epi32(a, b);
+  }
+  enum : uint32_t { lane_bits = 0x1111U };
+};
+
+template <typename U>
+inline size_t find_unit_sse2(const void *s, size_t n, uint32_t c) noexcept
+{
+  using ops = unit_ops_sse2<sizeof(U)>;
+  const size_t per_block = 16 / sizeof(U);
+  const auto *p = static_cast<const unsigned char *>(s);
+  const __m128i v = ops::set1(c);
+  size_t i = 0;
+  for (; i + per_block <= n; i += per_block)
+  {
+    const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p + i * sizeof(U)));
+    const auto mask = static_cast<uint32_t>(_mm_movemask_epi8(ops::cmpeq(block, v)));
+    if (mask != 0) return i + static_cast<size_t>(ctz32(mask)) / sizeof(U);
+  }
+  const size_t rest = find_unit_scalar<U>(p + i * sizeof(U), n - i, c);
+  return rest != kernel_npos ? i + rest : kernel_npos;
+}
+
+template <typename U>
+inline size_t find_units_sse2(const void *s, size_t n, const void *needle, size_t m) noexcept
+{
+  if (m == 0) return 0;
+  if (m > n) return kernel_npos;
+  if (m == 1) return find_unit_sse2<U>(s, n, load_unit<U>(needle, 0));
+
+  using ops = unit_ops_sse2<sizeof(U)>;
+  const size_t per_block = 16 / sizeof(U);
+  const auto *p = static_cast<const unsigned char *>(s);
+  const auto *q = static_cast<const unsigned char *>(needle);
+  const __m128i first = ops::set1(load_unit<U>(needle, 0));
+  const __m128i last = ops::set1(load_unit<U>(needle, m - 1));
+  size_t i = 0;
+  for (; i + m - 1 + per_block <= n; i += per_block)
+  {
+    const __m128i block_first = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p + i * sizeof(U)));
+    const __m128i block_last = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p + (i + m - 1) * sizeof(U)));
+    auto mask = static_cast<uint32_t>(_mm_movemask_epi8(
+                  _mm_and_si128(ops::cmpeq(block_first, first), ops::cmpeq(block_last, last)))) &
+                ops::lane_bits;
+    while (mask != 0)
+    {
+      const size_t j = static_cast<size_t>(ctz32(mask)) / sizeof(U);
+      if (std::memcmp(p + (i + j + 1) * sizeof(U), q + sizeof(U), (m - 2) * sizeof(U)) == 0) return i + j;
+      mask &= mask - 1;
+    }
+  }
+  const size_t rest = find_units_scalar<U>(p + i * sizeof(U), n - i, needle, m);
+  return rest != kernel_npos ? i + rest : kernel_npos;
+}
+
+inline size_t mismatch_sse2(const void *a, const void *b, size_t n) noexcept
+{
+  const auto *pa = static_cast<const unsigned char *>(a);
+  const auto *pb = static_cast<const unsigned char *>(b);
+  size_t i = 0;
+  for (; i + 16 <= n; i += 16)
+  {
+    const __m128i eq = _mm_cmpeq_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i *>(pa + i)),
+                                      _mm_loadu_si128(reinterpret_cast<const __m128i *>(pb + i)));
+    const auto mask = static_cast<uint32_t>(_mm_movemask_epi8(eq)) ^ 0xFFFFU;
+    if (mask != 0) return i + static_cast<size_t>(ctz32(mask));
+  }
+  return i + mismatch_scalar(pa + i, pb + i, n - i);
+}
+
+// ---------- avx2 ----------
+
+ABIN_SV_TARGET_AVX2 inline size_t find_char_avx2(const char *s, size_t n, char c) noexcept
+{
+  const __m256i v = _mm256_set1_epi8(c);
+  size_t i = 0;
+  for (; i + 64 <= n; i += 64)
+  {
+    const __m256i e0 = _mm256_cmpeq_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(s + i)), v);
+    const __m256i e1 = _mm256_cmpeq_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(s + i + 32)), v);
+    if (_mm256_movemask_epi8(_mm256_or_si256(e0, e1)) != 0)
+    {
+      const auto m0 = static_cast<uint32_t>(_mm256_movemask_epi8(e0));
+      if (m0 != 0) return i + static_cast<size_t>(ctz32(m0));
+      return i + 32 + static_cast<size_t>(ctz32(static_cast<uint32_t>(_mm256_movemask_epi8(e1))));
+    }
+  }
+  for (; i + 32 <= n; i += 32)
+  {
+    const __m256i eq = _mm256_cmpeq_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(s + i)), v);
+    const auto mask = static_cast<uint32_t>(_mm256_movemask_epi8(eq));
+    if (mask != 0) return i + static_cast<size_t>(ctz32(mask));
+  }
+  const size_t rest = find_char_sse2(s + i, n - i, c);
+  return rest != kernel_npos ? i + rest : kernel_npos;
+}
+
+ABIN_SV_TARGET_AVX2 inline size_t rfind_char_avx2(const char *s, size_t n, char c) noexcept
+{
+  const __m256i v = _mm256_set1_epi8(c);
+  size_t i = n;
+  for (; i >= 32; i -= 32)
+  {
+    const __m256i eq = _mm256_cmpeq_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(s + i - 32)), v);
+    const auto mask = static_cast<uint32_t>(_mm256_movemask_epi8(eq));
+    if (mask != 0) return i - 32 + static_cast<size_t>(bsr32(mask));
+  }
+  return rfind_char_sse2(s, i, c);
+}
+
+ABIN_SV_TARGET_AVX2 inline size_t find_avx2(const char *s, size_t n, const char *needle, size_t m) noexcept
+{
+  if (m == 0) return 0;
+  if (m > n) return kernel_npos;
+  if (m == 1) return find_char_avx2(s, n, needle[0]);
+
+  const __m256i first = _mm256_set1_epi8(needle[0]);
+  const __m256i last = _mm256_set1_epi8(needle[m - 1]);
+  size_t i = 0;
+  for (; i + m - 1 + 32 <= n; i += 32)
+  {
+    const __m256i block_first = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(s + i));
+    const __m256i block_last = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(s + i + m - 1));
+    auto mask = static_cast<uint32_t>(_mm256_movemask_epi8(
+      _mm256_and_si256(_mm256_cmpeq_epi8(block_first, first), _mm256_cmpeq_epi8(block_last, last))));
+    while (mask != 0)
+    {
+      const auto bit = static_cast<size_t>(ctz32(mask));
+      if (std::memcmp(s + i + bit + 1, needle + 1, m - 2) == 0) return i + bit;
+      mask &= mask - 1;
+    }
+  }
+  const size_t rest = find_sse2(s + i, n - i, needle, m);
+  return rest != kernel_npos ? i + rest : kernel_npos;
+}
+
+ABIN_SV_TARGET_AVX2 inline size_t find_first_of_avx2(const char *s, size_t n, const char *set, size_t k) noexcept
+{
+  if (k == 0 || k > 16) return find_first_of_scalar(s, n, set, k);
+  if (k == 1) return find_char_avx2(s, n, set[0]);
+
+  __m256i needles[16];
+  for (size_t j = 0; j < k; ++j) needles[j] = _mm256_set1_epi8(set[j]);
+  size_t i = 0;
+  for (; i + 32 <= n; i += 32)
+  {
+    const __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(s + i));
+    __m256i eq = _mm256_cmpeq_epi8(block, needles[0]);
+    for (size_t j = 1; j < k; ++j) eq = _mm256_or_si256(eq, _mm256_cmpeq_epi8(block, needles[j]));
+    const auto mask = static_cast<uint32_t>(_mm256_movemask_epi8(eq));
+    if (mask != 0) return i + static_cast<size_t>(ctz32(mask));
+  }
+  const size_t rest = find_first_of_sse2(s + i, n - i, set, k);
+  return rest != kernel_npos ? i + rest : kernel_npos;
+}
+
+// ---------- avx2: 16/32 位代码单元 ----------
+
+template <size_t W>
+struct unit_ops_avx2;
+
+template <>
+struct unit_ops_avx2<2> {
+  ABIN_SV_TARGET_AVX2 static __m256i set1(uint32_t c) noexcept
+  {
+    return _mm256_set1_epi16(static_cast<short>(c));
+  }
+  ABIN_SV_TARGET_AVX2 static __m256i cmpeq(__m256i a, __m256i b) noexcept
+  {
+    return _mm256_cmpeq_epi16(a, b);
+  }
+  enum : uint32_t { lane_bits = 0x55555555U };
+};
+
+template <>
+struct unit_ops_avx2<4> {
+  ABIN_SV_TARGET_AVX2 static __m256i set1(uint32_t c) noexcept
+  {
+    return _mm256_set1_epi32(static_cast<int>(c));
+  }
+  ABIN_SV_TARGET_AVX2 static __m256i cmpeq(__m256i a, __m256i b) noexcept
+  {
+    return _mm256_cmpeq_epi32(a, b);
+  }
+  enum : uint32_t { lane_bits = 0x11111111U };
+};
+
+template <typename U>
+ABIN_SV_TARGET_AVX2 inline size_t find_unit_avx2(const void *s, size_t n, uint32_t c) noexcept
+{
+  using ops = unit_ops_avx2<sizeof(U)>;
+  const size_t per_block = 32 / sizeof(U);
+  const auto *p = static_cast<const unsigned char *>(s);
+  const __m256i v = ops::set1(c);
+  size_t i = 0;
+  for (; i + per_block <= n; i += per_block)
+  {
+    const __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p + i * sizeof(U)));
+    const auto mask = static_cast<uint32_t>(_mm256_movemask_epi8(ops::cmpeq(block, v)));
+    if (mask != 0) return i + static_cast<size_t>(ctz32(mask)) / sizeof(U);
+  }
+  const size_t rest = find_unit_sse2<U>(p + i * sizeof(U), n - i, c);
+  return rest != kernel_npos ? i + rest : kernel_npos;
+}
+
+template <typename U>
+ABIN_SV_TARGET_AVX2 inline size_t find_units_avx2(const void *s, size_t n, const void *needle, size_t m) noexcept
+{
+  if (m == 0) return 0;
+  if (m > n) return kernel_npos;
+  if (m == 1) return find_unit_avx2<U>(s, n, load_unit<U>(needle, 0));
+
+  using ops = unit_ops_avx2<sizeof(U)>;
+  const size_t per_block = 32 / sizeof(U);
+  const auto *p = static_cast<const unsigned char *>(s);
+  const auto *q = static_cast<const unsigned char *>(needle);
+  const __m256i first = ops::set1(load_unit<U>(needle, 0));
+  const __m256i last = ops::set1(load_unit<U>(needle, m - 1));
+  size_t i = 0;
+  for (; i + m - 1 + per_block <= n; i += per_block)
+  {
+    const __m256i block_first = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p + i * sizeof(U)));
+    const __m256i block_last = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p + (i + m - 1) * sizeof(U)));
+    auto mask = static_cast<uint32_t>(_mm256_movemask_epi8(
+                  _mm256_and_si256(ops::cmpeq(block_first, first), ops::cmpeq(block_last, last)))) &
+                ops::lane_bits;
+    while (mask != 0)
+    {
+      const size_t j = static_cast<size_t>(ctz32(mask)) / sizeof(U);
+      if (std::memcmp(p + (i + j + 1) * sizeof(U), q + sizeof(U), (m - 2) * sizeof(U)) == 0) return i + j;
+      mask &= mask - 1;
+    }
+  }
+  const size_t rest = find_units_sse2<U>(p + i * sizeof(U), n - i, needle, m);
+  return rest != kernel_npos ? i + rest : kernel_npos;
+}
+
+ABIN_SV_TARGET_AVX2 inline size_t mismatch_avx2(const void *a, const void *b, size_t n) noexcept
+{
+  const auto *pa = static_cast<const unsigned char *>(a);
+  const auto *pb = static_cast<const unsigned char *>(b);
+  size_t i = 0;
+  for (; i + 32 <= n; i += 32)
+  {
+    const __m256i eq = _mm256_cmpeq_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(pa + i)),
+                                         _mm256_loadu_si256(reinterpret_cast<const __m256i *>(pb + i)));
+    const auto mask = ~static_cast<uint32_t>(_mm256_movemask_epi8(eq));
+    if (mask != 0) return i + static_cast<size_t>(ctz32(mask));
+  }
+  return i + mismatch_sse2(pa + i, pb + i, n - i);
+}
+#endif
+
+}  // namespace detail
+}  // namespace abin
@@ -0,0 +1,251 @@
+/**************************************************************************************************************
+ *~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ * @file: utf8_kernels.h
+ * @description: UTF-8 解码/校验/计数的各指令集内核(库内部使用).
+ * - utf8_validate_scalar : 8 字节 ASCII 快速路径 + 逐码点解码
+ * - utf8_validate_ssse3  : Keller/Lemire 查表算法, 每次处理 16 字节
+ * - utf8_count_sse2      : movemask + popcount 统计非续字节
+ * - 校验内核由 abin/dispatch.h 在运行期按 CPU 能力选择.
+ *~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ **************************************************************************************************************/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include "abin/detail/simd.h"
+
+namespace abin
+{
+namespace detail
+{
+
+/**
+ * @brief 解码一个 UTF-8 码点
+ * @param p 序列起始位置
+ * @param n 可用字节数(必须 > 0)
+ * @param cp 输出码点
+ * @return 序列长度(1~4), 非法或截断时返回 0
+ */
+inline size_t utf8_decode(const unsigned char *p, size_t n, char32_t &cp) noexcept
+{
+  const unsigned char c0 = p[0];
+  if (c0 < 0x80)
+  {
+    cp = c0;
+    return 1;
+  }
+  if (c0 < 0xC2) return 0;  // 续字节或过长的 2 字节前导(C0/C1)
+  if (c0 < 0xE0)
+  {
+    if (n < 2 || (p[1] & 0xC0) != 0x80) return 0;
+    cp = (static_cast<char32_t>(c0 & 0x1F) << 6) | (p[1] & 0x3F);
+    return 2;
+  }
+  if (c0 < 0xF0)
+  {
+    if (n < 3) return 0;
+    // E0 后必须 >= A0(否则过长), ED 后必须 <= 9F(否则是代理项)
+    const unsigned char lo = (c0 == 0xE0) ? 0xA0 : 0x80;
+    const unsigned char hi = (c0 == 0xED) ? 0x9F : 0xBF;
+    if (p[1] < lo || p[1] > hi || (p[2] & 0xC0) != 0x80) return 0;
+    cp = (static_cast<char32_t>(c0 & 0x0F) << 12) | (static_cast<char32_t>(p[1] & 0x3F) << 6) | (p[2] & 0x3F);
+    return 3;
+  }
+  if (c0 < 0xF5)
+  {
+    if (n < 4) return 0;
+    // F0 后必须 >= 90(否则过长), F4 后必须 <= 8F(否则超过 U+10FFFF)
+    const unsigned char lo = (c0 == 0xF0) ? 0x90 : 0x80;
+    const unsigned char hi = (c0 == 0xF4) ? 0x8F : 0xBF;
+    if (p[1] < lo || p[1] > hi || (p[2] & 0xC0) != 0x80 || (p[3] & 0xC0) != 0x80) return 0;
+    cp = (static_cast<char32_t>(c0 & 0x07) << 18) | (static_cast<char32_t>(p[1] & 0x3F) << 12) |
+         (static_cast<char32_t>(p[2] & 0x3F) << 6) | (p[3] & 0x3F);
+    return 4;
+  }
+  return 0;
+}
+
+// 标量校验: 8 字节 ASCII 快速路径 + 逐码点解码
+inline bool utf8_validate_scalar(const unsigned char *p, size_t n) noexcept
+{
+  size_t i = 0;
+  while (i < n)
+  {
+    if (i + 8 <= n && (load_u64(p + i) & 0x8080808080808080ULL) == 0)
+    {
+      i += 8;
+      continue;
+    }
+    if (p[i] < 0x80)
+    {
+      ++i;
+      continue;
+    }
+    char32_t cp = 0;
+    const size_t len = utf8_decode(p + i, n - i, cp);
+    if (len == 0) return false;
+    i += len;
+  }
+  return true;
+}
+
+// 标量计数: 统计非续字节(不是 10xxxxxx)的个数
+inline size_t utf8_count_scalar(const unsigned char *p, size_t n) noexcept
+{
+  size_t count = 0;
+  for (size_t i = 0; i < n; ++i)
+  {
+    count += static_cast<size_t>((p[i] & 0xC0) != 0x80);
+  }
+  return count;
+}
+
+#if defined(ABIN_SV_HAS_SSE2)
+inline size_t utf8_count_sse2(const unsigned char *p, size_t n) noexcept
+{
+  size_t count = 0;
+  size_t i = 0;
+  // 续字节以有符号形式看是 [-128, -65], 其余字节都 > -65
+  const __m128i threshold = _mm_set1_epi8(-65);
+  for (; i + 16 <= n; i += 16)
+  {
+    const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p + i));
+    const int mask = _mm_movemask_epi8(_mm_cmpgt_epi8(v, threshold));
+    count += static_cast<size_t>(popcount32(static_cast<uint32_t>(mask)));
+  }
+  return count + utf8_count_scalar(p + i, n - i);
+}
+#endif
+
+#if defined(ABIN_SV_HAS_SSE2)
+// Keller/Lemire 查表校验("Validating UTF-8 In Less Than One Instruction Per Byte").
+// 用前一字节的高/低半字节和当前字节的高半字节各查一张 16 项表, 三者按位与后非 0 即为错误;
+// 3/4 字节序列的第 3/4 字节是否必须为续字节, 通过饱和减法单独检查.
+// 所有用到 SSSE3 指令的成员都带 ABIN_SV_TARGET_SSSE3 标记, 只能在运行期确认 CPU 支持 SSSE3 后调用.
+class utf8_checker_ssse3
+{
+ public:
+  utf8_checker_ssse3() noexcept :
+    error_(_mm_setzero_si128()), prev_input_(_mm_setzero_si128()), prev_incomplete_(_mm_setzero_si128())
+  {}
+
+  ABIN_SV_TARGET_SSSE3 void check_block(__m128i input) noexcept
+  {
+    if (_mm_movemask_epi8(input) == 0)
+    {
+      // 纯 ASCII 块: 只需确认上一块末尾没有未完成的多字节序列
+      error_ = _mm_or_si128(error_, prev_incomplete_);
+      prev_incomplete_ = _mm_setzero_si128();
+    }
+    else
+    {
+      const __m128i prev1 = _mm_alignr_epi8(input, prev_input_, 15);
+      const __m128i sc = special_cases(input, prev1);
+      error_ = _mm_or_si128(error_, multibyte_lengths(input, prev_input_, sc));
+      prev_incomplete_ = is_incomplete(input);
+    }
+    prev_input_ = input;
+  }
+
+  bool finish() noexcept
+  {
+    error_ = _mm_or_si128(error_, prev_incomplete_);
+    return _mm_movemask_epi8(_mm_cmpeq_epi8(error_, _mm_setzero_si128())) == 0xFFFF;
+  }
+
+ private:
+  static __m128i shr4(__m128i v) noexcept
+  {
+    return _mm_and_si128(_mm_srli_epi16(v, 4), _mm_set1_epi8(0x0F));
+  }
+
+  ABIN_SV_TARGET_SSSE3 static __m128i special_cases(__m128i input, __m128i prev1) noexcept
+  {
+    const char TOO_SHORT = 1 << 0;   // 11______ 0_______ / 11______ 11______
+    const char TOO_LONG = 1 << 1;    // 0_______ 10______
+    const char OVERLONG_3 = 1 << 2;  // 11100000 100_____
+    const char TOO_LARGE = 1 << 3;   // 11110100 1001____ 及更大
+    const char SURROGATE = 1 << 4;   // 11101101 101_____
+    const char OVERLONG_2 = 1 << 5;  // 1100000_ 10______
+    const char TOO_LARGE_1000 = 1 << 6;                             // 11110101 1000____ 及更大
+    const char OVERLONG_4 = 1 << 6;                                 // 11110000 1000____
+    const char TWO_CONTS = static_cast<char>(1 << 7);               // 10______ 10______
+    const char CARRY = static_cast<char>(TOO_SHORT | TOO_LONG | TWO_CONTS);  // 与前一字节低半字节无关的错误
+
+    const __m128i byte_1_high_table =
+      _mm_setr_epi8(TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG, TWO_CONTS,
+                    TWO_CONTS, TWO_CONTS, TWO_CONTS, TOO_SHORT | OVERLONG_2, TOO_SHORT,
+                    TOO_SHORT | OVERLONG_3 | SURROGATE, TOO_SHORT | TOO_LARGE | TOO_LARGE_1000 | OVERLONG_4);
+    const __m128i byte_1_low_table = _mm_setr_epi8(
+      static_cast<char>(CARRY | OVERLONG_3 | OVERLONG_2 | OVERLONG_4), static_cast<char>(CARRY | OVERLONG_2), CARRY,
+      CARRY, static_cast<char>(CARRY | TOO_LARGE), static_cast<char>(CARRY | TOO_LARGE | TOO_LARGE_1000),
+      static_cast<char>(CARRY | TOO_LARGE | TOO_LARGE_1000), static_cast<char>(CARRY | TOO_LARGE | TOO_LARGE_1000),
+      static_cast<char>(CARRY | TOO_LARGE | TOO_LARGE_1000), static_cast<char>(CARRY | TOO_LARGE | TOO_LARGE_1000),
+      static_cast<char>(CARRY | TOO_LARGE | TOO_LARGE_1000), static_cast<char>(CARRY | TOO_LARGE | TOO_LARGE_1000),
+      static_cast<char>(CARRY | TOO_LARGE | TOO_LARGE_1000),
+      static_cast<char>(CARRY | TOO_LARGE | TOO_LARGE_1000 | SURROGATE),
+      static_cast<char>(CARRY | TOO_LARGE | TOO_LARGE_1000), static_cast<char>(CARRY | TOO_LARGE | TOO_LARGE_1000));
+    const __m128i byte_2_high_table = _mm_setr_epi8(
+      TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT,
+      static_cast<char>(TOO_LONG | OVERLONG_2 | TWO_CONTS | OVERLONG_3 | TOO_LARGE_1000 | OVERLONG_4),
+      static_cast<char>(TOO_LONG | OVERLONG_2 | TWO_CONTS | OVERLONG_3 | TOO_LARGE),
+      static_cast<char>(TOO_LONG | OVERLONG_2 | TWO_CONTS | SURROGATE | TOO_LARGE),
+      static_cast<char>(TOO_LONG | OVERLONG_2 | TWO_CONTS | SURROGATE | TOO_LARGE), TOO_SHORT, TOO_SHORT, TOO_SHORT,
+      TOO_SHORT);
+
+    const __m128i byte_1_high = _mm_shuffle_epi8(byte_1_high_table, shr4(prev1));
+    const __m128i byte_1_low = _mm_shuffle_epi8(byte_1_low_table, _mm_and_si128(prev1, _mm_set1_epi8(0x0F)));
+    const __m128i byte_2_high = _mm_shuffle_epi8(byte_2_high_table, shr4(input));
+    return _mm_and_si128(_mm_and_si128(byte_1_high, byte_1_low), byte_2_high);
+  }
+
+  ABIN_SV_TARGET_SSSE3 static __m128i multibyte_lengths(__m128i input, __m128i prev_input, __m128i sc) noexcept
+  {
+    const __m128i prev2 = _mm_alignr_epi8(input, prev_input, 14);
+    const __m128i prev3 = _mm_alignr_epi8(input, prev_input, 13);
+    // 前 2 字节 >= E0 或前 3 字节 >= F0 时, 当前字节必须是续字节(结果最高位为 1)
+    const __m128i is_third_byte = _mm_subs_epu8(prev2, _mm_set1_epi8(static_cast<char>(0xE0 - 0x80)));
+    const __m128i is_fourth_byte = _mm_subs_epu8(prev3, _mm_set1_epi8(static_cast<char>(0xF0 - 0x80)));
+    const __m128i must23_80 =
+      _mm_and_si128(_mm_or_si128(is_third_byte, is_fourth_byte), _mm_set1_epi8(static_cast<char>(0x80)));
+    return _mm_xor_si128(must23_80, sc);
+  }
+
+  // 块末尾 3 字节中是否有尚未结束的多字节前导
+  static __m128i is_incomplete(__m128i input) noexcept
+  {
+    const __m128i max_value = _mm_setr_epi8(-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+                                            static_cast<char>(0xF0 - 1), static_cast<char>(0xE0 - 1),
+                                            static_cast<char>(0xC0 - 1));
+    return _mm_subs_epu8(input, max_value);
+  }
+
+  __m128i error_;
+  __m128i prev_input_;
+  __m128i prev_incomplete_;
+};
+
+ABIN_SV_TARGET_SSSE3 inline bool utf8_validate_ssse3(const unsigned char *p, size_t n) noexcept
+{
+  utf8_checker_ssse3 checker;
+  size_t i = 0;
+  for (; i + 16 <= n; i += 16)
+  {
+    checker.check_block(_mm_loadu_si128(reinterpret_cast<const __m128i *>(p + i)));
+  }
+  if (i < n)
+  {
+    // 尾部不足 16 字节: 补 0(ASCII)后按整块处理, 截断序列会被识别为 TOO_SHORT
+    unsigned char tail[16] = {0};
+    std::memcpy(tail, p + i, n - i);
+    checker.check_block(_mm_loadu_si128(reinterpret_cast<const __m128i *>(tail)));
+  }
+  return checker.finish();
+}
+#endif
+
+}  // namespace detail
+}  // namespace abin
@@ -0,0 +1,640 @@
+/**************************************************************************************************************
+ *~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ * @file: dispatch.h
+ * @description: abin::string_view 算法内核的运行期选择.
+ * - 首次使用时通过 CPUID 探测一次 CPU 能力(SSE2 / SSSE3 / SSE4.2 / AVX2, 含操作系统对 AVX 状态的支持),
+ *   为每个算法绑定当前 CPU 支持的最高指令集内核(函数指针), 同一个二进制可以部署到不同主机上.
+ * - 环境变量:
+ *   - ABIN_STRING_VIEW_ISA=scalar|sse2|ssse3|avx2 : 强制使用指定指令集(不超过 CPU 实际支持的级别),
+ *     便于可复现的基准测试;
+ *   - ABIN_STRING_VIEW_CALIBRATE=1 : 启动时对候选内核做微基准测试, 为每个算法绑定实测最快者.
+ * - 也可以在程序中调用 force_isa() / calibrate() / reset_to_default(), 通过 selected_isa() 查询结果.
+ * - 绑定通过原子函数指针完成, 可在任意线程中安全地重新绑定.
+ * - 这里只包含 string_view 本身使用的核心内核. 扩展组件(abin/codec.h、abin/escape.h)在各自的头文件中用 feature_slot
+ *   保存自己的内核, 按 requested_isa() 惰性绑定, 只使用 string_view 的翻译单元不会编译这些内核.
+ *~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ **************************************************************************************************************/
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <new>
+
+#include "abin/detail/simd.h"
+#include "abin/detail/string_kernels.h"
+#include "abin/detail/utf8_kernels.h"
+
+#if defined(ABIN_SV_X86) && (defined(__GNUC__) || defined(__clang__))
+#include <cpuid.h>
+#endif
+
+namespace abin
+{
+namespace dispatch
+{
+
+// 指令集级别, 数值越大越高
+enum class isa : unsigned { scalar, sse2, ssse3, avx2 };
+
+// 可被分派的算法
+enum class function : unsigned {
+  find_char,      // find(char) / contains(char)
+  rfind_char,     // rfind(char)
+  find,           // find(string_view) / contains(string_view)
+  find_first_of,  // find_first_of(string_view)
+  validate_utf8,  // is_valid_utf8
+  find_char16,    // 16 位代码单元的 find(CharT)(char16_t, Windows 上的 wchar_t)
+  find16,         // 16 位代码单元的 find(basic_string_view)
+  find_char32,    // 32 位代码单元的 find(CharT)(char32_t, 类 Unix 上的 wchar_t)
+  find32,         // 32 位代码单元的 find(basic_string_view)
+  mismatch,       // 宽字符 compare 使用的首个不等字节查找
+  count_          // 算法个数, 不是合法的算法
+};
+
+enum : size_t { function_count = static_cast<size_t>(function::count_) };
+
+inline const char *isa_name(isa level) noexcept
+{
+  switch (level)
+  {
+  case isa::scalar:
+    return "scalar";
+  case isa::sse2:
+    return "sse2";
+  case isa::ssse3:
+    return "ssse3";
+  case isa::avx2:
+    return "avx2";
+  }
+  return "unknown";
+}
+
+inline const char *function_name(function f) noexcept
+{
+  static const char *const names[function_count] = {"find_char",   "rfind_char", "find",        "find_first_of",
+                                                    "validate_utf8", "find_char16", "find16",    "find_char32",
+                                                    "find32",        "mismatch"};
+  const auto idx = static_cast<size_t>(f);
+  return idx < function_count ? names[idx] : "unknown";
+}
+
+/**
+ * @brief 解析指令集名称(不区分大小写)
+ * @param name 名称, 如 "avx2"
+ * @param out 解析结果
+ * @return 名称合法返回 true
+ */
+inline bool parse_isa(const char *name, isa &out) noexcept
+{
+  if (name == nullptr) return false;
+  const isa all[] = {isa::scalar, isa::sse2, isa::ssse3, isa::avx2};
+  for (isa level : all)
+  {
+    // 逐字符比较(转小写), 不分配内存
+    const char *expected = isa_name(level);
+    size_t i = 0;
+    for (; name[i] != '\0' && expected[i] != '\0'; ++i)
+    {
+      const char c = name[i];
+      if (((c >= 'A' && c <= 'Z') ? c - 'A' + 'a' : c) != expected[i]) break;
+    }
+    if (name[i] == '\0' && expected[i] == '\0')
+    {
+      out = level;
+      return true;
+    }
+  }
+  return false;
+}
+
+// CPU 能力(已考虑操作系统是否保存 AVX 寄存器状态)
+struct cpu_features {
+  bool sse2 = false;
+  bool ssse3 = false;
+  bool sse42 = false;
+  bool avx2 = false;
+};
+
+namespace detail
+{
+
+inline cpu_features detect_cpu() noexcept
+{
+  cpu_features f;
+#if defined(ABIN_SV_X86)
+  uint32_t ecx1 = 0;
+  uint32_t edx1 = 0;
+  uint32_t ebx7 = 0;
+  uint64_t xcr0 = 0;
+#if defined(_MSC_VER) && !defined(__clang__)
+  int regs[4] = {0, 0, 0, 0};
+  __cpuid(regs, 0);
+  const int max_leaf = regs[0];
+  __cpuid(regs, 1);
+  ecx1 = static_cast<uint32_t>(regs[2]);
+  edx1 = static_cast<uint32_t>(regs[3]);
+  if (max_leaf >= 7)
+  {
+    __cpuidex(regs, 7, 0);
+    ebx7 = static_cast<uint32_t>(regs[1]);
+  }
+  if ((ecx1 & (1U << 27)) != 0) xcr0 = _xgetbv(0);
+#else
+  unsigned a = 0;
+  unsigned b = 0;
+  unsigned c = 0;
+  unsigned d = 0;
+  const unsigned max_leaf = __get_cpuid_max(0, nullptr);
+  if (max_leaf >= 1 && __get_cpuid(1, &a, &b, &c, &d) != 0)
+  {
+    ecx1 = c;
+    edx1 = d;
+  }
+  if (max_leaf >= 7)
+  {
+    __cpuid_count(7, 0, a, b, c, d);
+    ebx7 = b;
+  }
+  if ((ecx1 & (1U << 27)) != 0)  // OSXSAVE: 可以用 xgetbv 查询操作系统保存了哪些寄存器状态
+  {
+    uint32_t lo = 0;
+    uint32_t hi = 0;
+    __asm__ __volatile__("xgetbv" : "=a"(lo), "=d"(hi) : "c"(0));
+    xcr0 = (static_cast<uint64_t>(hi) << 32) | lo;
+  }
+#endif
+  const bool os_avx = (xcr0 & 0x6) == 0x6;  // XMM 与 YMM 状态均被保存
+  f.sse2 = (edx1 & (1U << 26)) != 0;
+  f.ssse3 = (ecx1 & (1U << 9)) != 0;
+  f.sse42 = (ecx1 & (1U << 20)) != 0;
+  f.avx2 = os_avx && (ecx1 & (1U << 28)) != 0 && (ebx7 & (1U << 5)) != 0;
+#endif
+  return f;
+}
+
+// 环境变量值的缓冲区长度; 合法的取值都很短, 更长的值按未设置处理
+enum : size_t { env_buffer_size = 16 };
+
+/**
+ * @brief 把环境变量读入定长缓冲区(不分配内存, 可在 noexcept 的初始化中调用)
+ * @param name 变量名
+ * @param buf 输出缓冲区, 以 '\0' 结尾
+ * @return 变量存在且长度小于缓冲区时返回 true, 否则 buf 为空串并返回 false
+ */
+inline bool get_env(const char *name, char (&buf)[env_buffer_size]) noexcept
+{
+  buf[0] = '\0';
+#if defined(_MSC_VER)
+  size_t len = 0;
+  if (getenv_s(&len, buf, env_buffer_size, name) != 0 || len == 0)
+  {
+    buf[0] = '\0';
+    return false;
+  }
+  return true;
+#else
+  const char *v = std::getenv(name);
+  if (v == nullptr) return false;
+  const size_t len = std::strlen(v);
+  if (len >= env_buffer_size) return false;
+  std::memcpy(buf, v, len + 1);
+  return true;
+#endif
+}
+
+using find_char_fn = size_t (*)(const char *, size_t, char);
+using rfind_char_fn = size_t (*)(const char *, size_t, char);
+using find_fn = size_t (*)(const char *, size_t, const char *, size_t);
+using find_first_of_fn = size_t (*)(const char *, size_t, const char *, size_t);
+using validate_utf8_fn = bool (*)(const unsigned char *, size_t);
+using find_unit_fn = size_t (*)(const void *, size_t, uint32_t);
+using find_units_fn = size_t (*)(const void *, size_t, const void *, size_t);
+using mismatch_fn = size_t (*)(const void *, const void *, size_t);
+
+// 某一指令集级别下各算法可用的最佳内核; 没有专门实现时沿用较低级别的内核
+struct kernel_set {
+  find_char_fn find_char;
+  rfind_char_fn rfind_char;
+  find_fn find;
+  find_first_of_fn find_first_of;
+  validate_utf8_fn validate_utf8;
+  find_unit_fn find_char16;
+  find_units_fn find16;
+  find_unit_fn find_char32;
+  find_units_fn find32;
+  mismatch_fn mismatch;
+};
+
+inline kernel_set kernels_for(isa level) noexcept
+{
+  using namespace abin::detail;  // NOLINT(google-build-using-namespace)
+  kernel_set k = {find_char_scalar,
+                  rfind_char_scalar,
+                  find_scalar,
+                  find_first_of_scalar,
+                  utf8_validate_scalar,
+                  find_unit_scalar<uint16_t>,
+                  find_units_scalar<uint16_t>,
+                  find_unit_scalar<uint32_t>,
+                  find_units_scalar<uint32_t>,
+                  mismatch_scalar};
+#if defined(ABIN_SV_HAS_SSE2)
+  if (level >= isa::sse2)
+  {
+    k = {find_char_sse2,
+         rfind_char_sse2,
+         find_sse2,
+         find_first_of_sse2,
+         utf8_validate_scalar,
+         find_unit_sse2<uint16_t>,
+         find_units_sse2<uint16_t>,
+         find_unit_sse2<uint32_t>,
+         find_units_sse2<uint32_t>,
+         mismatch_sse2};
+  }
+  if (level >= isa::ssse3)
+  {
+    k.validate_utf8 = utf8_validate_ssse3;
+  }
+  if (level >= isa::avx2)
+  {
+    k = {find_char_avx2,
+         rfind_char_avx2,
+         find_avx2,
+         find_first_of_avx2,
+         utf8_validate_ssse3,
+         find_unit_avx2<uint16_t>,
+         find_units_avx2<uint16_t>,
+         find_unit_avx2<uint32_t>,
+         find_units_avx2<uint32_t>,
+         mismatch_avx2};
+  }
+#else
+  (void)level;
+#endif
+  return k;
+}
+
+// 算法 f 在请求级别 level 下实际使用的内核级别(部分算法没有每个级别的专门实现)
+inline isa effective_isa(function f, isa level) noexcept
+{
+#if defined(ABIN_SV_HAS_SSE2)
+  if (f == function::validate_utf8)
+  {
+    if (level >= isa::ssse3) return isa::ssse3;
+    return isa::scalar;
+  }
+  if (level == isa::ssse3) return isa::sse2;
+  return level;
+#else
+  (void)f;
+  (void)level;
+  return isa::scalar;
+#endif
+}
+
+// 当前绑定的内核及其指令集级别
+struct state {
+  std::atomic<find_char_fn> find_char;
+  std::atomic<rfind_char_fn> rfind_char;
+  std::atomic<find_fn> find;
+  std::atomic<find_first_of_fn> find_first_of;
+  std::atomic<validate_utf8_fn> validate_utf8;
+  std::atomic<find_unit_fn> find_char16;
+  std::atomic<find_units_fn> find16;
+  std::atomic<find_unit_fn> find_char32;
+  std::atomic<find_units_fn> find32;
+  std::atomic<mismatch_fn> mismatch;
+  std::atomic<unsigned> selected[function_count];
+  std::atomic<unsigned> requested;   // 最近一次 bind_all 的级别, 扩展组件的内核槽按它绑定
+  std::atomic<unsigned> generation;  // 每次 bind_all 加 1, 扩展组件的内核槽据此发现需要重新绑定
+  cpu_features cpu;
+  isa best;
+
+  state() noexcept;
+
+  void bind(function f, isa level) noexcept
+  {
+    const kernel_set k = kernels_for(level);
+    switch (f)
+    {
+    case function::find_char:
+      find_char.store(k.find_char, std::memory_order_relaxed);
+      break;
+    case function::rfind_char:
+      rfind_char.store(k.rfind_char, std::memory_order_relaxed);
+      break;
+    case function::find:
+      find.store(k.find, std::memory_order_relaxed);
+      break;
+    case function::find_first_of:
+      find_first_of.store(k.find_first_of, std::memory_order_relaxed);
+      break;
+    case function::validate_utf8:
+      validate_utf8.store(k.validate_utf8, std::memory_order_relaxed);
+      break;
+    case function::find_char16:
+      find_char16.store(k.find_char16, std::memory_order_relaxed);
+      break;
+    case function::find16:
+      find16.store(k.find16, std::memory_order_relaxed);
+      break;
+    case function::find_char32:
+      find_char32.store(k.find_char32, std::memory_order_relaxed);
+      break;
+    case function::find32:
+      find32.store(k.find32, std::memory_order_relaxed);
+      break;
+    case function::mismatch:
+      mismatch.store(k.mismatch, std::memory_order_relaxed);
+      break;
+    case function::count_:
+      return;
+    }
+    selected[static_cast<size_t>(f)].store(static_cast<unsigned>(effective_isa(f, level)), std::memory_order_relaxed);
+  }
+
+  void bind_all(isa level) noexcept
+  {
+    for (size_t i = 0; i < function_count; ++i) bind(static_cast<function>(i), level);
+    requested.store(static_cast<unsigned>(level), std::memory_order_relaxed);
+    generation.fetch_add(1, std::memory_order_release);
+  }
+
+  static state &instance() noexcept
+  {
+    static state s;
+    return s;
+  }
+};
+
+// 对一个候选内核计时: 重复多轮取最小值, 降低调度抖动的影响
+template <typename Fn>
+inline double time_kernel(Fn fn) noexcept
+{
+  using clock = std::chrono::steady_clock;
+  double best = 1e300;
+  volatile size_t sink = 0;
+  for (int round = 0; round < 5; ++round)
+  {
+    const auto t0 = clock::now();
+    for (int i = 0; i < 64; ++i) sink = sink + fn();
+    const double ns = std::chrono::duration<double, std::nano>(clock::now() - t0).count();
+    if (ns < best) best = ns;
+  }
+  return best;
+}
+
+// 微基准使用的缓冲区
+struct calibration_buffers {
+  enum : size_t { size = 4096 };
+  char text[size];
+  char text2[size];  // text 的副本, 供 mismatch 比较
+};
+
+// 微基准: 对每个算法测量所有可用指令集级别的内核, 绑定最快者.
+// 缓冲区以 nothrow 方式分配, 分配失败时保留当前绑定, 因此可以在 noexcept 的首次初始化中调用
+inline void calibrate(state &st) noexcept
+{
+  std::unique_ptr<calibration_buffers> buffers(new (std::nothrow) calibration_buffers);
+  if (!buffers) return;
+  calibration_buffers &b = *buffers;
+  const size_t n = calibration_buffers::size;
+  // 4KB 伪随机 ASCII 文本, 目标放在末尾以测量完整扫描的吞吐
+  uint32_t seed = 2463534242U;
+  for (char &c : b.text)
+  {
+    seed ^= seed << 13;
+    seed ^= seed >> 17;
+    seed ^= seed << 5;
+    c = static_cast<char>('a' + seed % 26);
+  }
+  b.text[n - 1] = '#';
+  const char *needle = b.text + n - 12;
+  const size_t needle_size = 12;
+  const char *s = b.text;
+  const auto *u = reinterpret_cast<const unsigned char *>(s);
+  // 宽字符内核直接把同一段文本当作 16/32 位代码单元序列, 目标同样位于末尾
+  std::memcpy(b.text2, b.text, n);
+  const size_t n16 = n / 2;
+  const size_t n32 = n / 4;
+  const uint32_t last16 = abin::detail::load_unit<uint16_t>(s, n16 - 1);
+  const uint32_t last32 = abin::detail::load_unit<uint32_t>(s, n32 - 1);
+
+  const isa all[] = {isa::scalar, isa::sse2, isa::ssse3, isa::avx2};
+  for (size_t f = 0; f < function_count; ++f)
+  {
+    isa best_level = isa::scalar;
+    double best_ns = 1e300;
+    for (isa level : all)
+    {
+      if (level > st.best) break;
+      const kernel_set k = kernels_for(level);
+      double ns = 0.0;
+      switch (static_cast<function>(f))
+      {
+      case function::find_char:
+        ns = time_kernel([&] { return k.find_char(s, n, '#'); });
+        break;
+      case function::rfind_char:
+        ns = time_kernel([&] { return k.rfind_char(s, n, '\n'); });
+        break;
+      case function::find:
+        ns = time_kernel([&] { return k.find(s, n, needle, needle_size); });
+        break;
+      case function::find_first_of:
+        ns = time_kernel([&] { return k.find_first_of(s, n, "#$%&", 4); });
+        break;
+      case function::validate_utf8:
+        ns = time_kernel([&] { return static_cast<size_t>(k.validate_utf8(u, n)); });
+        break;
+      case function::find_char16:
+        ns = time_kernel([&] { return k.find_char16(s, n16, last16); });
+        break;
+      case function::find16:
+        ns = time_kernel([&] { return k.find16(s, n16, needle, needle_size / 2); });
+        break;
+      case function::find_char32:
+        ns = time_kernel([&] { return k.find_char32(s, n32, last32); });
+        break;
+      case function::find32:
+        ns = time_kernel([&] { return k.find32(s, n32, needle, needle_size / 4); });
+        break;
+      case function::mismatch:
+        ns = time_kernel([&] { return k.mismatch(s, b.text2, n); });
+        break;
+      case function::count_:
+        break;
+      }
+      // 相差不足 5% 时优先选择更高级别(通常在更长输入上优势更明显)
+      if (ns < best_ns * 1.05)
+      {
+        best_ns = std::min(ns, best_ns);
+        best_level = level;
+      }
+    }
+    st.bind(static_cast<function>(f), best_level);
+  }
+}
+
+inline state::state() noexcept : requested(0), generation(0), cpu(detect_cpu()), best(isa::scalar)
+{
+#if defined(ABIN_SV_HAS_SSE2)
+  if (cpu.sse2) best = isa::sse2;
+  if (cpu.sse2 && cpu.ssse3) best = isa::ssse3;
+  if (cpu.sse2 && cpu.ssse3 && cpu.avx2) best = isa::avx2;
+#endif
+  bind_all(best);
+
+  char env[env_buffer_size];
+  isa forced = isa::scalar;
+  if (get_env("ABIN_STRING_VIEW_ISA", env) && parse_isa(env, forced))
+  {
+    bind_all(forced < best ? forced : best);
+  }
+  else
+  {
+    const bool cal = get_env("ABIN_STRING_VIEW_CALIBRATE", env) && env[0] != '\0';
+    if (cal && !(env[0] == '0' && env[1] == '\0')) calibrate(*this);
+  }
+}
+
+}  // namespace detail
+
+// 探测到的 CPU 能力
+inline const cpu_features &cpu() noexcept
+{
+  return detail::state::instance().cpu;
+}
+
+// 当前 CPU 与编译配置下可用的最高指令集级别
+inline isa best_supported_isa() noexcept
+{
+  return detail::state::instance().best;
+}
+
+// 算法 f 当前绑定的内核所属指令集(可能低于请求的级别, 例如 find 没有 SSSE3 专用内核时为 sse2)
+inline isa selected_isa(function f) noexcept
+{
+  return static_cast<isa>(detail::state::instance().selected[static_cast<size_t>(f)].load(std::memory_order_relaxed));
+}
+
+/**
+ * @brief 强制所有算法使用指定指令集的内核
+ * @param level 指令集级别
+ * @return CPU 支持该级别返回 true; 否则不做修改并返回 false
+ */
+inline bool force_isa(isa level) noexcept
+{
+  detail::state &st = detail::state::instance();
+  if (level > st.best) return false;
+  st.bind_all(level);
+  return true;
+}
+
+// 恢复为 CPU 支持的最高指令集(忽略环境变量)
+inline void reset_to_default() noexcept
+{
+  detail::state &st = detail::state::instance();
+  st.bind_all(st.best);
+}
+
+// 对候选内核做微基准测试, 为每个算法绑定实测最快者(耗时约数百微秒); 不影响扩展组件的内核槽
+inline void calibrate() noexcept
+{
+  detail::calibrate(detail::state::instance());
+}
+
+// 当前请求的指令集级别: 默认为 best_supported_isa(), 可被 ABIN_STRING_VIEW_ISA 或 force_isa() 降低
+inline isa requested_isa() noexcept
+{
+  return static_cast<isa>(detail::state::instance().requested.load(std::memory_order_relaxed));
+}
+
+/**
+ * @brief 扩展组件的内核槽: 保存一个按指令集级别选择的函数指针, 不占用核心分派表
+ * @tparam Fn 函数指针类型
+ * @note 首次调用 get() 时用 select(requested_isa()) 绑定; force_isa() / reset_to_default() 改变级别后,
+ *       下一次 get() 自动重新绑定. 构造函数是 constexpr, 作为函数内的静态变量时在编译期完成初始化.
+ */
+template <typename Fn>
+class feature_slot
+{
+ public:
+  using select_fn = Fn (*)(isa);
+
+  explicit constexpr feature_slot(select_fn select) noexcept : select_(select), fn_(nullptr), generation_(0) {}
+
+  Fn get() noexcept
+  {
+    const detail::state &st = detail::state::instance();
+    const unsigned g = st.generation.load(std::memory_order_acquire);
+    if (generation_.load(std::memory_order_acquire) != g)
+    {
+      // 并发的重新绑定得到的都是 CPU 支持的内核, 先写指针再写纪元, 读到新纪元时指针也已更新
+      fn_.store(select_(static_cast<isa>(st.requested.load(std::memory_order_relaxed))), std::memory_order_relaxed);
+      generation_.store(g, std::memory_order_release);
+    }
+    return fn_.load(std::memory_order_relaxed);
+  }
+
+ private:
+  select_fn select_;
+  std::atomic<Fn> fn_;
+  std::atomic<unsigned> generation_;  // fn_ 绑定时的 state::generation, 0 表示尚未绑定
+};
+
+// ---------- 当前绑定的内核(库内部使用) ----------
+namespace kernels
+{
+inline detail::find_char_fn find_char() noexcept
+{
+  return detail::state::instance().find_char.load(std::memory_order_relaxed);
+}
+inline detail::rfind_char_fn rfind_char() noexcept
+{
+  return detail::state::instance().rfind_char.load(std::memory_order_relaxed);
+}
+inline detail::find_fn find() noexcept
+{
+  return detail::state::instance().find.load(std::memory_order_relaxed);
+}
+inline detail::find_first_of_fn find_first_of() noexcept
+{
+  return detail::state::instance().find_first_of.load(std::memory_order_relaxed);
+}
+inline detail::validate_utf8_fn validate_utf8() noexcept
+{
+  return detail::state::instance().validate_utf8.load(std::memory_order_relaxed);
+}
+inline detail::find_unit_fn find_char16() noexcept
+{
+  return detail::state::instance().find_char16.load(std::memory_order_relaxed);
+}
+inline detail::find_units_fn find16() noexcept
+{
+  return detail::state::instance().find16.load(std::memory_order_relaxed);
+}
+inline detail::find_unit_fn find_char32() noexcept
+{
+  return detail::state::instance().find_char32.load(std::memory_order_relaxed);
+}
+inline detail::find_units_fn find32() noexcept
+{
+  return detail::state::instance().find32.load(std::memory_order_relaxed);
+}
+inline detail::mismatch_fn mismatch() noexcept
+{
+  return detail::state::instance().mismatch.load(std::memory_order_relaxed);
+}
+}  // namespace kernels
+
+}  // namespace dispatch
+}  // namespace abin
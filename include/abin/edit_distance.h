@@ -0,0 +1,239 @@
+/**************************************************************************************************************
+ *~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ * @file: edit_distance.h
+ * @description: 基于 abin::string_view 的 Levenshtein 编辑距离与近似查找.
+ * - 使用 Myers / Hyyrö 位并行算法: 动态规划矩阵的一列编码为两个位向量(+1 / -1 垂直差分),
+ *   每处理一个文本字符只需常数次位运算, 时间复杂度 O(ceil(m / 64) * n).
+ * - 较短串不超过 64 字节时只用一个机器字, 不分配任何内存; 更长时按 64 位分块, 块间传递水平差分.
+ * - within_distance : 判断距离是否不超过 k, 利用剩余列数给出的上下界提前结束.
+ * - fuzzy_find      : 在文本中查找与模式编辑距离不超过 k 的第一个子串.
+ *~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ **************************************************************************************************************/
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "abin/string_view.h"
+
+namespace abin
+{
+
+namespace detail
+{
+
+// 一个 64 行的块: pv / mv 的第 i 位表示 D[i][j] - D[i-1][j] 为 +1 / -1
+struct myers_block {
+  uint64_t pv;
+  uint64_t mv;
+};
+
+/**
+ * @brief 用文本的一个字符推进一个块(Myers 1999, advance_block)
+ * @param b 块状态
+ * @param eq 该字符在本块中出现的位置掩码
+ * @param hin 从上一块(或首行)传入的水平差分, 取值 -1 / 0 / +1
+ * @param high 本块最后一行对应的位
+ * @return 本块最后一行的水平差分
+ */
+inline int myers_advance(myers_block &b, uint64_t eq, int hin, uint64_t high) noexcept
+{
+  const uint64_t pv = b.pv;
+  const uint64_t mv = b.mv;
+  const uint64_t xv = eq | mv;
+  if (hin < 0) eq |= 1;
+  const uint64_t xh = (((eq & pv) + pv) ^ pv) | eq;
+  uint64_t ph = mv | ~(xh | pv);
+  uint64_t mh = pv & xh;
+  int hout = 0;
+  if ((ph & high) != 0) hout = 1;
+  if ((mh & high) != 0) hout = -1;
+  ph <<= 1;
+  mh <<= 1;
+  if (hin < 0) mh |= 1;
+  if (hin > 0) ph |= 1;
+  b.pv = mh | ~(xv | ph);
+  b.mv = ph & xv;
+  return hout;
+}
+
+// 读取 s 的第 i 个字节; Reverse 为 true 时从末尾往前数, 使反向比较不必拷贝出反转的字符串
+template <bool Reverse>
+inline unsigned char byte_at(string_view s, size_t i) noexcept
+{
+  return static_cast<unsigned char>(Reverse ? s[s.size() - 1 - i] : s[i]);
+}
+
+/**
+ * @brief 以 pattern 为行、text 为列运行位并行动态规划
+ * @tparam Reverse true: 把 pattern 与 text 都当作反转后的字符串处理
+ * @param search true: 首行为 0(子串近似查找); false: 首行为 j(整体编辑距离)
+ * @param on_column 每处理一列后调用 on_column(已处理列数, D[m][j]), 返回 false 时提前结束
+ * @return 最后处理的一列的 D[m][j]
+ */
+template <bool Reverse = false, typename OnColumn>
+inline size_t myers_run(string_view pattern, string_view text, bool search, OnColumn on_column)
+{
+  const size_t m = pattern.size();
+  size_t score = m;
+  const int top_hin = search ? 0 : 1;
+  if (m <= 64)
+  {
+    uint64_t peq[256] = {};
+    for (size_t i = 0; i < m; ++i) peq[byte_at<Reverse>(pattern, i)] |= uint64_t{1} << i;
+    const uint64_t high = uint64_t{1} << (m - 1);
+    myers_block b = {~uint64_t{0}, 0};
+    for (size_t j = 0; j < text.size(); ++j)
+    {
+      score += myers_advance(b, peq[byte_at<Reverse>(text, j)], top_hin, high);
+      if (!on_column(j + 1, score)) break;
+    }
+    return score;
+  }
+
+  const size_t words = (m + 63) / 64;
+  std::vector<uint64_t> peq(256 * words, 0);
+  for (size_t i = 0; i < m; ++i)
+  {
+    peq[byte_at<Reverse>(pattern, i) * words + i / 64] |= uint64_t{1} << (i % 64);
+  }
+  std::vector<myers_block> blocks(words, myers_block{~uint64_t{0}, 0});
+  const uint64_t last_high = uint64_t{1} << ((m - 1) % 64);
+  for (size_t j = 0; j < text.size(); ++j)
+  {
+    const uint64_t *eq = &peq[byte_at<Reverse>(text, j) * words];
+    int h = top_hin;
+    for (size_t w = 0; w + 1 < words; ++w) h = myers_advance(blocks[w], eq[w], h, uint64_t{1} << 63);
+    score += myers_advance(blocks[words - 1], eq[words - 1], h, last_high);
+    if (!on_column(j + 1, score)) break;
+  }
+  return score;
+}
+
+// 去掉公共前缀与公共后缀(不影响编辑距离), 并使 a 为较短的一个
+inline void trim_common(string_view &a, string_view &b) noexcept
+{
+  size_t p = 0;
+  const size_t n = std::min(a.size(), b.size());
+  while (p < n && a[p] == b[p]) ++p;
+  a.remove_prefix(p);
+  b.remove_prefix(p);
+  size_t s = 0;
+  const size_t r = std::min(a.size(), b.size());
+  while (s < r && a[a.size() - 1 - s] == b[b.size() - 1 - s]) ++s;
+  a.remove_suffix(s);
+  b.remove_suffix(s);
+  if (a.size() > b.size()) a.swap(b);
+}
+
+}  // namespace detail
+
+/**
+ * @brief 计算 a 与 b 的 Levenshtein 编辑距离(插入、删除、替换代价均为 1)
+ * @param a 字符串 a
+ * @param b 字符串 b
+ * @return 编辑距离
+ * @note 较短串(去掉公共前后缀后)不超过 64 字节时不分配内存
+ */
+inline size_t edit_distance(string_view a, string_view b)
+{
+  detail::trim_common(a, b);
+  if (a.empty()) return b.size();
+  return detail::myers_run(a, b, false, [](size_t, size_t) { return true; });
+}
+
+/**
+ * @brief 判断 a 与 b 的编辑距离是否不超过 k
+ * @param a 字符串 a
+ * @param b 字符串 b
+ * @param k 距离上限
+ * @return 距离 <= k 返回 true
+ * @note 长度差超过 k 时直接返回 false; 处理到第 j 列时, 最终距离落在 [D - (n - j), D + (n - j)] 内,
+ *       一旦该区间完全位于 k 的某一侧即提前结束
+ */
+inline bool within_distance(string_view a, string_view b, size_t k)
+{
+  const size_t diff = a.size() > b.size() ? a.size() - b.size() : b.size() - a.size();
+  if (diff > k) return false;
+  if (k == 0) return a == b;
+  detail::trim_common(a, b);
+  if (a.empty()) return b.size() <= k;
+
+  const size_t n = b.size();
+  bool result = false;
+  bool decided = false;
+  const size_t score = detail::myers_run(a, b, false, [&](size_t j, size_t d) {
+    const size_t rest = n - j;
+    if (d > k + rest)
+    {
+      decided = true;
+      result = false;
+    }
+    else if (d + rest <= k)
+    {
+      decided = true;
+      result = true;
+    }
+    return !decided;
+  });
+  return decided ? result : score <= k;
+}
+
+// fuzzy_find 的结果
+struct fuzzy_match {
+  size_t pos;       // 匹配子串在文本中的起始位置, 找不到时为 string_view::npos
+  size_t length;    // 匹配子串的长度
+  size_t distance;  // 匹配子串与模式的编辑距离
+
+  explicit operator bool() const noexcept
+  {
+    return pos != string_view::npos;
+  }
+};
+
+/**
+ * @brief 在 haystack 中查找与 needle 编辑距离不超过 k 的第一个子串
+ * @param haystack 被查找的文本
+ * @param needle 模式
+ * @param k 允许的最大编辑距离
+ * @param pos 起始位置(默认 0)
+ * @return 结束位置最靠前的匹配; 同一结束位置取距离最小、长度最短的起点. 找不到时 pos 为 npos
+ * @note 先用 "首行为 0" 的位并行查找确定结束位置, 再对反转后的模式与文本做一次有界的整体比较确定起点.
+ *       反向比较直接按反向下标读取原字符串, needle 不超过 64 字节时整个查找不分配内存
+ */
+inline fuzzy_match fuzzy_find(string_view haystack, string_view needle, size_t k, size_t pos = 0)
+{
+  const fuzzy_match none = {string_view::npos, 0, 0};
+  if (pos > haystack.size()) return none;
+  if (needle.size() <= k) return {pos, 0, needle.size()};  // 空串即可满足
+
+  const string_view text = haystack.substr(pos);
+  size_t end = string_view::npos;
+  size_t best = 0;
+  detail::myers_run(needle, text, true, [&](size_t j, size_t d) {
+    if (d > k) return true;
+    end = j;
+    best = d;
+    return false;
+  });
+  if (end == string_view::npos) return none;
+
+  // 匹配长度不超过 m + k: 在反转的窗口上求整体编辑距离, 取达到最小距离的最短长度
+  const size_t window = std::min(end, needle.size() + k);
+  size_t length = 0;
+  size_t min_d = needle.size();
+  detail::myers_run<true>(needle, text.substr(end - window, window), false, [&](size_t t, size_t d) {
+    if (d < min_d)
+    {
+      min_d = d;
+      length = t;
+    }
+    return min_d > best;
+  });
+  return {pos + end - length, length, min_d};
+}
+
+}  // namespace abin
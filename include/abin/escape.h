@@ -0,0 +1,580 @@
+/**************************************************************************************************************
+ *~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ * @file: escape.h
+ * @description: 基于 abin::string_view 的 JSON 与 C 风格字符串转义/反转义.
+ * - 零拷贝快速路径: 输入中没有需要处理的字符时, 直接返回输入本身(指向输入的 string_view), 不写输出缓冲区.
+ * - 否则结果写入调用者提供的缓冲区(char * 或 std::string), 返回指向缓冲区的 string_view.
+ * - 转义: 用向量内核(SSE2 / AVX2, 运行期选择, 见 abin/dispatch.h 的 feature_slot)查找下一个需要转义的字符,
+ *   中间的整段用 memcpy 复制.
+ *   - JSON: '"' '\\' 与控制字符(< 0x20); 使用 \b \f \n \r \t 短形式, 其余写为 \u00XX. 不转义 '/' 与非 ASCII 字节.
+ *   - C   : 同上再加 DEL(0x7F); 使用 \a \b \f \n \r \t \v 短形式, 其余写为 3 位八进制 \ooo
+ *     (固定 3 位, 后面紧跟数字字符也不会产生歧义). 不转义非 ASCII 字节.
+ * - 反转义: 用 find('\\') (向量 find_char 内核)跳到下一个反斜杠, 输出不会长于输入, 缓冲区取 in.size() 即可.
+ *   - JSON: \" \\ \/ \b \f \n \r \t \uXXXX; 代理对合并后编码为 UTF-8, 孤立的代理项视为错误.
+ *   - C   : \a \b \f \n \r \t \v \\ \' \" \?, 1~3 位八进制, \x 加任意位十六进制(值不超过 0xFF).
+ *   - 非法或被截断的转义序列返回其反斜杠的位置(unescape_result::error_pos), 缓冲区中此前的结果有效.
+ *   - 不检查未转义的原始字节(例如 JSON 字符串中的控制字符), 原样复制.
+ *~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ **************************************************************************************************************/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+#include "abin/detail/codec_kernels.h"
+#include "abin/detail/escape_kernels.h"
+#include "abin/detail/string_kernels.h"
+#include "abin/dispatch.h"
+#include "abin/string_view.h"
+
+namespace abin
+{
+
+// 反转义结果
+struct unescape_result {
+  string_view value;  // 结果: 零拷贝时指向输入, 否则指向输出缓冲区; 出错时为出错前已写出的部分
+  size_t error_pos;   // 第一个非法转义序列的反斜杠位置; 成功时为 string_view::npos
+
+  bool ok() const noexcept
+  {
+    return error_pos == string_view::npos;
+  }
+  explicit operator bool() const noexcept
+  {
+    return ok();
+  }
+};
+
+namespace detail
+{
+
+using find_escape_fn = size_t (*)(const char *, size_t, char);
+
+inline find_escape_fn select_find_escape(dispatch::isa level) noexcept
+{
+#if defined(ABIN_SV_HAS_SSE2)
+  if (level >= dispatch::isa::avx2) return find_escape_avx2;
+  if (level >= dispatch::isa::sse2) return find_escape_sse2;
+#else
+  (void)level;
+#endif
+  return find_escape_scalar;
+}
+
+// 当前绑定的 find_escape 内核; 转义内核不在核心分派表中, 首次使用时按 requested_isa() 绑定
+inline find_escape_fn find_escape_kernel() noexcept
+{
+  static dispatch::feature_slot<find_escape_fn> slot(select_find_escape);
+  return slot.get();
+}
+
+// JSON 与 C 风格转义的差异
+struct json_escape_traits {
+  static char extra() noexcept
+  {
+    return '"';  // 不增加额外字符
+  }
+
+  static size_t escaped_length(unsigned char c) noexcept
+  {
+    switch (c)
+    {
+    case '"':
+    case '\\':
+    case '\b':
+    case '\f':
+    case '\n':
+    case '\r':
+    case '\t':
+      return 2;
+    default:
+      return 6;
+    }
+  }
+
+  static size_t write(unsigned char c, char *out) noexcept
+  {
+    char letter = 0;
+    switch (c)
+    {
+    case '"':
+      letter = '"';
+      break;
+    case '\\':
+      letter = '\\';
+      break;
+    case '\b':
+      letter = 'b';
+      break;
+    case '\f':
+      letter = 'f';
+      break;
+    case '\n':
+      letter = 'n';
+      break;
+    case '\r':
+      letter = 'r';
+      break;
+    case '\t':
+      letter = 't';
+      break;
+    default:
+      break;
+    }
+    out[0] = '\\';
+    if (letter != 0)
+    {
+      out[1] = letter;
+      return 2;
+    }
+    static const char digits[] = "0123456789abcdef";
+    out[1] = 'u';
+    out[2] = '0';
+    out[3] = '0';
+    out[4] = digits[c >> 4];
+    out[5] = digits[c & 0xF];
+    return 6;
+  }
+};
+
+struct c_escape_traits {
+  static char extra() noexcept
+  {
+    return '\x7F';
+  }
+
+  // 短形式的字母, 没有时返回 0
+  static char letter(unsigned char c) noexcept
+  {
+    switch (c)
+    {
+    case '"':
+      return '"';
+    case '\\':
+      return '\\';
+    case '\a':
+      return 'a';
+    case '\b':
+      return 'b';
+    case '\f':
+      return 'f';
+    case '\n':
+      return 'n';
+    case '\r':
+      return 'r';
+    case '\t':
+      return 't';
+    case '\v':
+      return 'v';
+    default:
+      return 0;
+    }
+  }
+
+  static size_t escaped_length(unsigned char c) noexcept
+  {
+    return letter(c) != 0 ? 2 : 4;
+  }
+
+  static size_t write(unsigned char c, char *out) noexcept
+  {
+    out[0] = '\\';
+    const char l = letter(c);
+    if (l != 0)
+    {
+      out[1] = l;
+      return 2;
+    }
+    out[1] = static_cast<char>('0' + (c >> 6));
+    out[2] = static_cast<char>('0' + ((c >> 3) & 7));
+    out[3] = static_cast<char>('0' + (c & 7));
+    return 4;
+  }
+};
+
+template <typename Traits>
+inline size_t escaped_size(string_view in) noexcept
+{
+  const auto find = find_escape_kernel();
+  const char *s = in.data();
+  const size_t n = in.size();
+  size_t total = n;
+  size_t i = 0;
+  while (i < n)
+  {
+    const size_t hit = find(s + i, n - i, Traits::extra());
+    if (hit == kernel_npos) break;
+    i += hit;
+    total += Traits::escaped_length(static_cast<unsigned char>(s[i])) - 1;
+    ++i;
+  }
+  return total;
+}
+
+// 从 first(第一个需要转义的字符)开始转义, 此前的部分原样复制; 返回写出的字节数
+template <typename Traits>
+inline size_t escape_from(string_view in, size_t first, char *out) noexcept
+{
+  const auto find = find_escape_kernel();
+  const char *s = in.data();
+  const size_t n = in.size();
+  std::memcpy(out, s, first);
+  size_t o = first;
+  size_t i = first;
+  while (true)
+  {
+    o += Traits::write(static_cast<unsigned char>(s[i]), out + o);
+    ++i;
+    const size_t hit = i < n ? find(s + i, n - i, Traits::extra()) : kernel_npos;
+    const size_t run = hit == kernel_npos ? n - i : hit;
+    std::memcpy(out + o, s + i, run);
+    o += run;
+    i += run;
+    if (hit == kernel_npos) return o;
+  }
+}
+
+template <typename Traits>
+inline string_view escape(string_view in, char *out) noexcept
+{
+  const size_t first = find_escape_kernel()(in.data(), in.size(), Traits::extra());
+  if (first == kernel_npos) return in;
+  return string_view(out, escape_from<Traits>(in, first, out));
+}
+
+template <typename Traits>
+inline string_view escape(string_view in, std::string &buf)
+{
+  const size_t first = find_escape_kernel()(in.data(), in.size(), Traits::extra());
+  if (first == kernel_npos) return in;
+  buf.resize(escaped_size<Traits>(in));
+  escape_from<Traits>(in, first, &buf[0]);
+  return string_view(buf);
+}
+
+// 把码点编码为 UTF-8, 返回写出的字节数
+inline size_t encode_utf8(uint32_t cp, char *out) noexcept
+{
+  if (cp < 0x80)
+  {
+    out[0] = static_cast<char>(cp);
+    return 1;
+  }
+  if (cp < 0x800)
+  {
+    out[0] = static_cast<char>(0xC0 | (cp >> 6));
+    out[1] = static_cast<char>(0x80 | (cp & 0x3F));
+    return 2;
+  }
+  if (cp < 0x10000)
+  {
+    out[0] = static_cast<char>(0xE0 | (cp >> 12));
+    out[1] = static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+    out[2] = static_cast<char>(0x80 | (cp & 0x3F));
+    return 3;
+  }
+  out[0] = static_cast<char>(0xF0 | (cp >> 18));
+  out[1] = static_cast<char>(0x80 | ((cp >> 12) & 0x3F));
+  out[2] = static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+  out[3] = static_cast<char>(0x80 | (cp & 0x3F));
+  return 4;
+}
+
+// 读取 s[i..i+4) 的 4 位十六进制数, 越界或非法返回 false
+inline bool read_hex4(string_view s, size_t i, uint32_t &value) noexcept
+{
+  if (s.size() < 4 || i > s.size() - 4) return false;
+  value = 0;
+  for (size_t k = 0; k < 4; ++k)
+  {
+    const unsigned d = hex_value(static_cast<unsigned char>(s[i + k]));
+    if (d > 0xF) return false;
+    value = (value << 4) | d;
+  }
+  return true;
+}
+
+/**
+ * @brief 解码 in[i] 处('\\')开始的一个 JSON 转义序列
+ * @param in 输入
+ * @param i 反斜杠的位置, 成功时更新为转义序列之后的位置
+ * @param out 输出位置
+ * @return 写出的字节数; 非法时返回 0
+ */
+inline size_t unescape_json_one(string_view in, size_t &i, char *out) noexcept
+{
+  if (i + 1 >= in.size()) return 0;
+  char c = 0;
+  switch (in[i + 1])
+  {
+  case '"':
+    c = '"';
+    break;
+  case '\\':
+    c = '\\';
+    break;
+  case '/':
+    c = '/';
+    break;
+  case 'b':
+    c = '\b';
+    break;
+  case 'f':
+    c = '\f';
+    break;
+  case 'n':
+    c = '\n';
+    break;
+  case 'r':
+    c = '\r';
+    break;
+  case 't':
+    c = '\t';
+    break;
+  case 'u':
+  {
+    uint32_t cp = 0;
+    if (!read_hex4(in, i + 2, cp)) return 0;
+    size_t next = i + 6;
+    if (cp >= 0xDC00 && cp <= 0xDFFF) return 0;  // 孤立的低代理项
+    if (cp >= 0xD800 && cp <= 0xDBFF)
+    {
+      uint32_t low = 0;
+      if (next + 1 >= in.size() || in[next] != '\\' || in[next + 1] != 'u' || !read_hex4(in, next + 2, low) ||
+          low < 0xDC00 || low > 0xDFFF)
+      {
+        return 0;
+      }
+      cp = 0x10000 + ((cp - 0xD800) << 10) + (low - 0xDC00);
+      next += 6;
+    }
+    i = next;
+    return encode_utf8(cp, out);
+  }
+  default:
+    return 0;
+  }
+  out[0] = c;
+  i += 2;
+  return 1;
+}
+
+// 解码 in[i] 处('\\')开始的一个 C 转义序列, 约定同 unescape_json_one
+inline size_t unescape_c_one(string_view in, size_t &i, char *out) noexcept
+{
+  if (i + 1 >= in.size()) return 0;
+  const char e = in[i + 1];
+  char c = 0;
+  switch (e)
+  {
+  case 'a':
+    c = '\a';
+    break;
+  case 'b':
+    c = '\b';
+    break;
+  case 'f':
+    c = '\f';
+    break;
+  case 'n':
+    c = '\n';
+    break;
+  case 'r':
+    c = '\r';
+    break;
+  case 't':
+    c = '\t';
+    break;
+  case 'v':
+    c = '\v';
+    break;
+  case '\\':
+  case '\'':
+  case '"':
+  case '?':
+    c = e;
+    break;
+  case 'x':
+  {
+    size_t j = i + 2;
+    uint32_t value = 0;
+    while (j < in.size() && hex_value(static_cast<unsigned char>(in[j])) <= 0xF)
+    {
+      value = (value << 4) | hex_value(static_cast<unsigned char>(in[j]));
+      if (value > 0xFF) return 0;
+      ++j;
+    }
+    if (j == i + 2) return 0;  // \x 后至少一位
+    out[0] = static_cast<char>(value);
+    i = j;
+    return 1;
+  }
+  default:
+  {
+    if (e < '0' || e > '7') return 0;
+    size_t j = i + 1;
+    uint32_t value = 0;
+    while (j < in.size() && j < i + 4 && in[j] >= '0' && in[j] <= '7')
+    {
+      value = (value << 3) | static_cast<uint32_t>(in[j] - '0');
+      ++j;
+    }
+    if (value > 0xFF) return 0;
+    out[0] = static_cast<char>(value);
+    i = j;
+    return 1;
+  }
+  }
+  out[0] = c;
+  i += 2;
+  return 1;
+}
+
+// 从 first(第一个反斜杠)开始反转义, 此前的部分原样复制
+template <size_t (*One)(string_view, size_t &, char *)>
+inline unescape_result unescape_from(string_view in, size_t first, char *out) noexcept
+{
+  std::memcpy(out, in.data(), first);
+  size_t o = first;
+  size_t i = first;
+  while (true)
+  {
+    const size_t w = One(in, i, out + o);
+    if (w == 0) return {string_view(out, o), i};
+    o += w;
+    const size_t hit = in.find('\\', i);
+    const size_t end = hit == string_view::npos ? in.size() : hit;
+    std::memcpy(out + o, in.data() + i, end - i);
+    o += end - i;
+    i = end;
+    if (hit == string_view::npos) return {string_view(out, o), string_view::npos};
+  }
+}
+
+template <size_t (*One)(string_view, size_t &, char *)>
+inline unescape_result unescape(string_view in, char *out) noexcept
+{
+  const size_t first = in.find('\\');
+  if (first == string_view::npos) return {in, string_view::npos};
+  return unescape_from<One>(in, first, out);
+}
+
+template <size_t (*One)(string_view, size_t &, char *)>
+inline unescape_result unescape(string_view in, std::string &buf)
+{
+  const size_t first = in.find('\\');
+  if (first == string_view::npos) return {in, string_view::npos};
+  buf.resize(in.size());
+  unescape_result r = unescape_from<One>(in, first, &buf[0]);
+  buf.resize(r.value.size());
+  r.value = string_view(buf);
+  return r;
+}
+
+}  // namespace detail
+
+// ---------- JSON ----------
+
+// 转义结果长度的上界(每个字节最多写为 \u00XX)
+inline size_t json_escape_bound(size_t n) noexcept
+{
+  return 6 * n;
+}
+
+// 转义结果的精确长度(需要扫描输入)
+inline size_t json_escaped_size(string_view in) noexcept
+{
+  return detail::escaped_size<detail::json_escape_traits>(in);
+}
+
+/**
+ * @brief 按 JSON 字符串的规则转义(不含两侧引号)
+ * @param in 输入
+ * @param out 输出缓冲区, 至少 json_escaped_size(in) 或 json_escape_bound(in.size()) 字节
+ * @return 无需转义时返回 in 本身(不写 out); 否则返回指向 out 的结果
+ */
+inline string_view escape_json(string_view in, char *out) noexcept
+{
+  return detail::escape<detail::json_escape_traits>(in, out);
+}
+
+/**
+ * @brief 按 JSON 字符串的规则转义, 结果写入 buf
+ * @param in 输入
+ * @param buf 输出缓冲区, 需要转义时被调整为结果的长度; 无需转义时不修改
+ * @return 无需转义时返回 in 本身; 否则返回指向 buf 的结果
+ */
+inline string_view escape_json(string_view in, std::string &buf)
+{
+  return detail::escape<detail::json_escape_traits>(in, buf);
+}
+
+/**
+ * @brief 反转义 JSON 字符串的内容(不含两侧引号)
+ * @param in 输入
+ * @param out 输出缓冲区, 至少 in.size() 字节
+ * @return 结果与错误位置; 没有反斜杠时 value 就是 in
+ */
+inline unescape_result unescape_json(string_view in, char *out) noexcept
+{
+  return detail::unescape<detail::unescape_json_one>(in, out);
+}
+
+// 反转义 JSON 字符串的内容, 结果写入 buf(没有反斜杠时不修改 buf)
+inline unescape_result unescape_json(string_view in, std::string &buf)
+{
+  return detail::unescape<detail::unescape_json_one>(in, buf);
+}
+
+// ---------- C ----------
+
+// 转义结果长度的上界(每个字节最多写为 \ooo)
+inline size_t c_escape_bound(size_t n) noexcept
+{
+  return 4 * n;
+}
+
+// 转义结果的精确长度(需要扫描输入)
+inline size_t c_escaped_size(string_view in) noexcept
+{
+  return detail::escaped_size<detail::c_escape_traits>(in);
+}
+
+/**
+ * @brief 按 C 字符串字面量的规则转义(不含两侧引号)
+ * @param in 输入
+ * @param out 输出缓冲区, 至少 c_escaped_size(in) 或 c_escape_bound(in.size()) 字节
+ * @return 无需转义时返回 in 本身(不写 out); 否则返回指向 out 的结果
+ */
+inline string_view escape_c(string_view in, char *out) noexcept
+{
+  return detail::escape<detail::c_escape_traits>(in, out);
+}
+
+// 按 C 字符串字面量的规则转义, 结果写入 buf(无需转义时不修改 buf)
+inline string_view escape_c(string_view in, std::string &buf)
+{
+  return detail::escape<detail::c_escape_traits>(in, buf);
+}
+
+/**
+ * @brief 反转义 C 字符串字面量的内容(不含两侧引号)
+ * @param in 输入
+ * @param out 输出缓冲区, 至少 in.size() 字节
+ * @return 结果与错误位置; 没有反斜杠时 value 就是 in
+ */
+inline unescape_result unescape_c(string_view in, char *out) noexcept
+{
+  return detail::unescape<detail::unescape_c_one>(in, out);
+}
+
+// 反转义 C 字符串字面量的内容, 结果写入 buf(没有反斜杠时不修改 buf)
+inline unescape_result unescape_c(string_view in, std::string &buf)
+{
+  return detail::unescape<detail::unescape_c_one>(in, buf);
+}
+
+}  // namespace abin
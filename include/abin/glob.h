@@ -0,0 +1,352 @@
+/**************************************************************************************************************
+ *~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ * @file: glob.h
+ * @description: 预编译的通配符匹配器(glob), 基于 abin::string_view.
+ * - 语法: `*` 匹配任意长度(含空)的字符序列, `?` 匹配任意单个字符,
+ *   `[abc]` / `[a-z]` / `[!a-z]`(或 `[^a-z]`) 字符类, `\x` 转义;
+ *   没有闭合 `]` 的 `[` 按普通字符处理(与 fnmatch 一致), 因此任何模式都能编译.
+ * - 匹配时间与文本长度成线性关系, 不会因为病态模式(如 `*a*a*a*b`)而指数回溯:
+ *   - 模式按 `*` 切分为若干段, 首段锚定在开头, 末段锚定在结尾;
+ *   - 中间各段依次取最左匹配(对 glob 而言最左匹配总是最优的), 段内用 Shift-And 位并行算法查找,
+ *     每个文本字符只被扫描一次.
+ * - 编译时提取字面量前缀、后缀与最长的必需字面量, 匹配前先用 starts_with / ends_with / find
+ *   (SIMD 内核)快速排除不可能匹配的文本.
+ *~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ **************************************************************************************************************/
+
+#pragma once
+
+#include <bitset>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "abin/string_view.h"
+
+namespace abin
+{
+
+// ---------- glob 类 ----------
+class glob
+{
+ public:
+  enum : size_t { npos = static_cast<size_t>(-1) };
+  // 作为预过滤条件的必需字面量的最大长度; 限制长度使 find 的最坏情况仍为线性
+  enum : size_t { max_prefilter_length = 32 };
+  // 段内 Shift-And 状态放在栈上的最大位置数, 更长的段在匹配时于堆上分配状态
+  enum : size_t { stack_state_positions = 1024 };
+
+  /**
+   * @brief 编译模式
+   * @param pattern 通配符模式
+   */
+  explicit glob(string_view pattern) : pattern_(pattern.to_string()), min_length_(0)
+  {
+    compile();
+  }
+
+  /**
+   * @brief 判断 text 是否与模式完全匹配
+   * @param text 待匹配的文本
+   * @return 匹配返回 true
+   * @note 两个 `*` 之间超过 stack_state_positions 个位置的段需要在堆上分配 Shift-And 状态,
+   *       可能抛出 std::bad_alloc; 其余模式匹配时不分配内存
+   */
+  bool match(string_view text) const
+  {
+    if (text.size() < min_length_) return false;
+    if (!text.starts_with(prefix_) || !text.ends_with(suffix_)) return false;
+    if (!required_.empty() && text.find(required_) == string_view::npos) return false;
+
+    const segment &first = segments_.front();
+    if (segments_.size() == 1) return text.size() == first.length && matches_at(first, text, 0);
+
+    // 首段锚定在开头, 末段锚定在结尾, 两者不能重叠
+    const segment &last = segments_.back();
+    if (!matches_at(first, text, 0)) return false;
+    const size_t tail = text.size() - last.length;
+    if (tail < first.length || !matches_at(last, text, tail)) return false;
+
+    // 中间各段在 [pos, tail) 内依次取最左匹配
+    size_t pos = first.length;
+    for (size_t i = 1; i + 1 < segments_.size(); ++i)
+    {
+      const segment &seg = segments_[i];
+      if (seg.length == 0) continue;
+      const size_t end = search(seg, text, pos, tail);
+      if (end == npos) return false;
+      pos = end;
+    }
+    return true;
+  }
+
+  bool operator()(string_view text) const
+  {
+    return match(text);
+  }
+
+  /**
+   * @brief 用同一个模式批量匹配多个文本
+   * @param texts 文本数组
+   * @param count 文本个数
+   * @param results 输出数组(长度至少为 count), results[i] 为 texts[i] 的匹配结果
+   * @return 匹配的文本个数
+   */
+  size_t match_many(const string_view *texts, size_t count, bool *results) const
+  {
+    size_t matched = 0;
+    for (size_t i = 0; i < count; ++i)
+    {
+      results[i] = match(texts[i]);
+      matched += results[i] ? 1 : 0;
+    }
+    return matched;
+  }
+
+  /**
+   * @brief 返回所有匹配文本的下标
+   * @param texts 文本列表
+   * @return 匹配文本在 texts 中的下标(升序)
+   */
+  std::vector<size_t> filter(const std::vector<string_view> &texts) const
+  {
+    std::vector<size_t> out;
+    for (size_t i = 0; i < texts.size(); ++i)
+    {
+      if (match(texts[i])) out.push_back(i);
+    }
+    return out;
+  }
+
+  const std::string &pattern() const noexcept
+  {
+    return pattern_;
+  }
+
+  // 所有匹配文本都必须具有的字面量前缀
+  string_view literal_prefix() const noexcept
+  {
+    return prefix_;
+  }
+
+  // 所有匹配文本都必须具有的字面量后缀
+  string_view literal_suffix() const noexcept
+  {
+    return suffix_;
+  }
+
+  // 所有匹配文本都必须包含的最长字面量(截断到 max_prefilter_length), 可能为空
+  string_view required_literal() const noexcept
+  {
+    return required_;
+  }
+
+  // 匹配文本的最小长度
+  size_t min_length() const noexcept
+  {
+    return min_length_;
+  }
+
+ private:
+  using char_set = std::bitset<256>;
+
+  // 两个 `*` 之间的一段模式, 每个位置是一个字符集合
+  struct segment {
+    size_t length = 0;
+    size_t words = 0;             // Shift-And 状态占用的 64 位字数
+    std::vector<uint64_t> masks;  // masks[c * words + w]: 字符 c 可出现在哪些位置
+  };
+
+  // 模式中的一个位置
+  struct unit {
+    char_set set;
+    bool literal;  // 只匹配一个确定的字符
+    char ch;
+  };
+
+  void compile()
+  {
+    std::vector<std::vector<unit>> parts(1);
+    const string_view p(pattern_);
+    size_t i = 0;
+    while (i < p.size())
+    {
+      const char c = p[i];
+      if (c == '*')
+      {
+        parts.emplace_back();
+        ++i;
+      }
+      else if (c == '?')
+      {
+        parts.back().push_back(unit{char_set().set(), false, '\0'});
+        ++i;
+      }
+      else if (c == '[' && parse_class(p, i, parts.back()))
+      {
+        // parse_class 已前进 i
+      }
+      else
+      {
+        const char lit = (c == '\\' && i + 1 < p.size()) ? p[++i] : c;
+        char_set s;
+        s.set(static_cast<unsigned char>(lit));
+        parts.back().push_back(unit{s, true, lit});
+        ++i;
+      }
+    }
+
+    for (const std::vector<unit> &units : parts)
+    {
+      segments_.push_back(build_segment(units));
+      min_length_ += units.size();
+      // 段内最长的连续字面量是必需的(截断后仍是必需的)
+      std::string run;
+      for (size_t k = 0; k <= units.size(); ++k)
+      {
+        if (k < units.size() && units[k].literal)
+        {
+          run.push_back(units[k].ch);
+          continue;
+        }
+        if (run.size() > required_.size()) required_ = run.substr(0, max_prefilter_length);
+        run.clear();
+      }
+    }
+    for (const unit &u : parts.front())
+    {
+      if (!u.literal) break;
+      prefix_.push_back(u.ch);
+    }
+    for (size_t k = parts.back().size(); k-- > 0 && parts.back()[k].literal;)
+    {
+      suffix_.insert(suffix_.begin(), parts.back()[k].ch);
+    }
+    // 已被前缀/后缀覆盖的必需字面量不再重复检查
+    if (string_view(prefix_).find(required_) != string_view::npos ||
+        string_view(suffix_).find(required_) != string_view::npos)
+    {
+      required_.clear();
+    }
+  }
+
+  // 解析以 p[i] == '[' 开头的字符类; 没有闭合的 ']' 时返回 false 且不修改 i
+  static bool parse_class(string_view p, size_t &i, std::vector<unit> &out)
+  {
+    size_t j = i + 1;
+    bool negate = false;
+    if (j < p.size() && (p[j] == '!' || p[j] == '^'))
+    {
+      negate = true;
+      ++j;
+    }
+    char_set s;
+    bool first = true;
+    while (j < p.size() && (p[j] != ']' || first))
+    {
+      first = false;
+      char lo = p[j];
+      if (lo == '\\' && j + 1 < p.size()) lo = p[++j];
+      ++j;
+      if (j + 1 < p.size() && p[j] == '-' && p[j + 1] != ']')
+      {
+        char hi = p[j + 1];
+        j += 2;
+        if (hi == '\\' && j < p.size()) hi = p[j++];
+        for (unsigned c = static_cast<unsigned char>(lo); c <= static_cast<unsigned char>(hi); ++c) s.set(c);
+      }
+      else
+      {
+        s.set(static_cast<unsigned char>(lo));
+      }
+    }
+    if (j >= p.size()) return false;
+    if (negate) s.flip();
+    out.push_back(unit{s, false, '\0'});
+    i = j + 1;
+    return true;
+  }
+
+  static segment build_segment(const std::vector<unit> &units)
+  {
+    segment seg;
+    seg.length = units.size();
+    seg.words = (units.size() + 63) / 64;
+    seg.masks.assign(256 * seg.words, 0);
+    for (size_t k = 0; k < units.size(); ++k)
+    {
+      for (size_t c = 0; c < 256; ++c)
+      {
+        if (units[k].set.test(c)) seg.masks[c * seg.words + k / 64] |= uint64_t{1} << (k % 64);
+      }
+    }
+    return seg;
+  }
+
+  // 位置 k 是否接受字符 c
+  static bool accepts(const segment &seg, size_t k, char c) noexcept
+  {
+    const size_t row = static_cast<unsigned char>(c) * seg.words;
+    return ((seg.masks[row + k / 64] >> (k % 64)) & 1) != 0;
+  }
+
+  // seg 是否恰好匹配 text[pos, pos + seg.length)
+  static bool matches_at(const segment &seg, string_view text, size_t pos) noexcept
+  {
+    for (size_t k = 0; k < seg.length; ++k)
+    {
+      if (!accepts(seg, k, text[pos + k])) return false;
+    }
+    return true;
+  }
+
+  // Shift-And: 在 text[from, to) 中查找 seg 的最左匹配, 返回匹配结束位置
+  static size_t search(const segment &seg, string_view text, size_t from, size_t to)
+  {
+    const size_t limit = to;
+    const size_t top = seg.length - 1;
+    if (seg.words == 1)
+    {
+      const uint64_t hit = uint64_t{1} << top;
+      uint64_t state = 0;
+      for (size_t j = from; j < limit; ++j)
+      {
+        state = ((state << 1) | 1) & seg.masks[static_cast<unsigned char>(text[j])];
+        if ((state & hit) != 0) return j + 1;
+      }
+      return npos;
+    }
+
+    uint64_t local[stack_state_positions / 64] = {};
+    std::vector<uint64_t> heap;
+    uint64_t *state = local;
+    if (seg.words > stack_state_positions / 64)
+    {
+      heap.assign(seg.words, 0);
+      state = heap.data();
+    }
+    for (size_t j = from; j < limit; ++j)
+    {
+      const uint64_t *row = &seg.masks[static_cast<unsigned char>(text[j]) * seg.words];
+      uint64_t carry = 1;
+      for (size_t w = 0; w < seg.words; ++w)
+      {
+        const uint64_t next_carry = state[w] >> 63;
+        state[w] = ((state[w] << 1) | carry) & row[w];
+        carry = next_carry;
+      }
+      if (((state[top / 64] >> (top % 64)) & 1) != 0) return j + 1;
+    }
+    return npos;
+  }
+
+  std::string pattern_;
+  std::vector<segment> segments_;  // 按 `*` 切分, 至少一段
+  size_t min_length_;
+  std::string prefix_;
+  std::string suffix_;
+  std::string required_;
+};
+
+}  // namespace abin
@@ -0,0 +1,213 @@
+/**************************************************************************************************************
+ *~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ * @file: hashed_string_view.h
+ * @description: 携带 hash 值的 abin::string_view, 同一个键在多个 hash 表中查找时只计算一次 hash.
+ * - hashed_string_view 在构造时计算 hash(与 std::hash<abin::string_view> 的结果相同)并与指针、长度一起保存;
+ *   也可以由调用者直接提供已知的 hash(例如 abin::rolling_hash 的窗口值).
+ * - std::hash<abin::hashed_string_view> 直接返回保存的 hash, 相等比较先比较 hash 与长度, 再比较字节,
+ *   因此 std::unordered_map<abin::hashed_string_view, V> 的查找不再扫描键的内容来求 hash.
+ * - 与普通 string_view 互通: hashed_string_view 可隐式转换为 string_view, 可与 string_view 直接比较;
+ *   由 string_view 构造 hashed_string_view(计算一次 hash)需要显式写出;
+ *   hashed_hash / hashed_equal 同时接受两种类型并声明 is_transparent, 在支持异构查找的容器
+ *   (C++20 的 unordered 容器)中可以直接用 string_view 查找.
+ *~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ **************************************************************************************************************/
+
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <ostream>
+#include <string>
+
+#include "abin/string_view.h"
+
+namespace abin
+{
+
+// ---------- hashed_string_view 类 ----------
+class hashed_string_view
+{
+ public:
+  hashed_string_view() noexcept : view_(), hash_(std::hash<string_view>()(string_view())) {}
+
+  // 计算并保存 sv 的 hash. 构造函数都是 explicit 的: 计算 hash 的位置一目了然,
+  // 且不会与 string_view 自身的比较运算符产生二义性
+  explicit hashed_string_view(string_view sv) noexcept : view_(sv), hash_(std::hash<string_view>()(sv)) {}
+
+  explicit hashed_string_view(const char *s) noexcept : hashed_string_view(string_view(s)) {}
+
+  explicit hashed_string_view(const std::string &s) noexcept : hashed_string_view(string_view(s)) {}
+
+  /**
+   * @brief 使用调用者提供的 hash 构造, 不扫描内容
+   * @param sv 视图
+   * @param hash sv 的 hash, 必须等于 std::hash<abin::string_view>()(sv)
+   */
+  hashed_string_view(string_view sv, size_t hash) noexcept : view_(sv), hash_(hash) {}
+
+  string_view view() const noexcept
+  {
+    return view_;
+  }
+
+  operator string_view() const noexcept  // NOLINT(google-explicit-constructor)
+  {
+    return view_;
+  }
+
+  size_t hash() const noexcept
+  {
+    return hash_;
+  }
+
+  const char *data() const noexcept
+  {
+    return view_.data();
+  }
+
+  size_t size() const noexcept
+  {
+    return view_.size();
+  }
+
+  bool empty() const noexcept
+  {
+    return view_.empty();
+  }
+
+  std::string to_string() const
+  {
+    return view_.to_string();
+  }
+
+ private:
+  string_view view_;
+  size_t hash_;
+};
+
+// 先比较 hash 与长度, 只有两者都相同时才比较字节
+inline bool operator==(const hashed_string_view &lhs, const hashed_string_view &rhs) noexcept
+{
+  return lhs.hash() == rhs.hash() && lhs.view() == rhs.view();
+}
+
+inline bool operator!=(const hashed_string_view &lhs, const hashed_string_view &rhs) noexcept
+{
+  return !(lhs == rhs);
+}
+
+inline bool operator==(const hashed_string_view &lhs, string_view rhs) noexcept
+{
+  return lhs.view() == rhs;
+}
+
+inline bool operator==(string_view lhs, const hashed_string_view &rhs) noexcept
+{
+  return lhs == rhs.view();
+}
+
+inline bool operator!=(const hashed_string_view &lhs, string_view rhs) noexcept
+{
+  return !(lhs == rhs);
+}
+
+inline bool operator!=(string_view lhs, const hashed_string_view &rhs) noexcept
+{
+  return !(lhs == rhs);
+}
+
+// 与字符串字面量和 std::string 比较时不必先计算 hash
+inline bool operator==(const hashed_string_view &lhs, const char *rhs) noexcept
+{
+  return lhs.view() == string_view(rhs);
+}
+
+inline bool operator==(const char *lhs, const hashed_string_view &rhs) noexcept
+{
+  return string_view(lhs) == rhs.view();
+}
+
+inline bool operator==(const hashed_string_view &lhs, const std::string &rhs) noexcept
+{
+  return lhs.view() == string_view(rhs);
+}
+
+inline bool operator==(const std::string &lhs, const hashed_string_view &rhs) noexcept
+{
+  return string_view(lhs) == rhs.view();
+}
+
+inline bool operator!=(const hashed_string_view &lhs, const char *rhs) noexcept
+{
+  return !(lhs == rhs);
+}
+
+inline bool operator!=(const char *lhs, const hashed_string_view &rhs) noexcept
+{
+  return !(lhs == rhs);
+}
+
+inline bool operator!=(const hashed_string_view &lhs, const std::string &rhs) noexcept
+{
+  return !(lhs == rhs);
+}
+
+inline bool operator!=(const std::string &lhs, const hashed_string_view &rhs) noexcept
+{
+  return !(lhs == rhs);
+}
+
+inline std::ostream &operator<<(std::ostream &os, const hashed_string_view &v)
+{
+  return os << v.view();
+}
+
+// ---------- 函数对象 ----------
+// 对 hashed_string_view 返回保存的 hash, 对 string_view 计算同样的 hash
+struct hashed_hash {
+  using is_transparent = void;
+
+  size_t operator()(const hashed_string_view &v) const noexcept
+  {
+    return v.hash();
+  }
+
+  size_t operator()(string_view v) const noexcept
+  {
+    return std::hash<string_view>()(v);
+  }
+};
+
+// 两侧都携带 hash 时先比较 hash
+struct hashed_equal {
+  using is_transparent = void;
+
+  bool operator()(const hashed_string_view &lhs, const hashed_string_view &rhs) const noexcept
+  {
+    return lhs == rhs;
+  }
+
+  bool operator()(const hashed_string_view &lhs, string_view rhs) const noexcept
+  {
+    return lhs.view() == rhs;
+  }
+
+  bool operator()(string_view lhs, const hashed_string_view &rhs) const noexcept
+  {
+    return lhs == rhs.view();
+  }
+};
+
+}  // namespace abin
+
+namespace std
+{
+template <>
+struct hash<abin::hashed_string_view> {
+  size_t operator()(const abin::hashed_string_view &v) const noexcept
+  {
+    return v.hash();
+  }
+};
+}  // namespace std
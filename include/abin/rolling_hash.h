@@ -0,0 +1,268 @@
+/**************************************************************************************************************
+ *~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ * @file: rolling_hash.h
+ * @description: 基于 abin::string_view 的滚动 hash 与内容定义分块(content-defined chunking).
+ * - rolling_hash : 固定窗口的 Rabin-Karp 多项式 hash, 窗口滑动一个字节只需 O(1);
+ *   与 std::hash<abin::string_view> 使用同一个多项式(基数 131, 模 2^64), 因此窗口的 hash 值
+ *   与对该窗口直接调用 std::hash 的结果相同, 可以和已有的 hash 表混用.
+ * - gear_table   : Gear hash 使用的 256 项随机表, 由固定种子的 splitmix64 生成, 跨平台一致.
+ * - cdc_chunker  : FastCDC 风格的分块器, 按内容把数据切成大小在 [min, max] 之间、平均约为 avg 的块;
+ *   插入或删除少量字节只影响附近的块, 适合去重. 实现要点:
+ *   - Gear hash: h = (h << 1) + gear[b], 每字节一次移位、一次加法、一次查表;
+ *   - 跳过前 min 字节(这些位置不可能切分);
+ *   - 归一化分块: 未达到 avg 时用更严格的掩码, 超过 avg 后用更宽松的掩码, 使块大小集中在 avg 附近;
+ *   - 掩码取 h 的高位, 高位受最近 64 字节影响, 低位只受最近几个字节影响.
+ *~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ **************************************************************************************************************/
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "abin/string_view.h"
+
+namespace abin
+{
+
+// ---------- rolling_hash 类 ----------
+class rolling_hash
+{
+ public:
+  enum : size_t { base = 131 };  // 与 detail::polynomial_hash 相同
+
+  /**
+   * @brief 构造窗口长度为 window 的滚动 hash
+   * @param window 窗口长度(字节), 为 0 时按 1 处理
+   */
+  explicit rolling_hash(size_t window) noexcept : window_(window != 0 ? window : 1), out_factor_(1), hash_(0), size_(0)
+  {
+    for (size_t i = 1; i < window_; ++i) out_factor_ *= base;
+  }
+
+  size_t window() const noexcept
+  {
+    return window_;
+  }
+
+  // 已加入的字节数(不超过窗口长度)
+  size_t size() const noexcept
+  {
+    return size_;
+  }
+
+  // 窗口是否已填满
+  bool full() const noexcept
+  {
+    return size_ == window_;
+  }
+
+  // 当前窗口的 hash, 等于 std::hash<abin::string_view> 对窗口内容的结果
+  size_t value() const noexcept
+  {
+    return hash_;
+  }
+
+  void reset() noexcept
+  {
+    hash_ = 0;
+    size_ = 0;
+  }
+
+  /**
+   * @brief 窗口未满时追加一个字节
+   * @param in 新字节
+   */
+  void push(char in) noexcept
+  {
+    hash_ = hash_ * base + static_cast<unsigned char>(in);
+    ++size_;
+  }
+
+  /**
+   * @brief 窗口已满时滑动一个字节: 移出 out, 移入 in
+   * @param out 离开窗口的字节(窗口中最早的字节)
+   * @param in 进入窗口的字节
+   */
+  void roll(char out, char in) noexcept
+  {
+    hash_ = (hash_ - static_cast<unsigned char>(out) * out_factor_) * base + static_cast<unsigned char>(in);
+  }
+
+ private:
+  size_t window_;
+  size_t out_factor_;  // base^(window - 1)
+  size_t hash_;
+  size_t size_;
+};
+
+/**
+ * @brief 依次计算 s 中每个长度为 window 的窗口的 hash
+ * @param s 输入
+ * @param window 窗口长度
+ * @param f 回调 f(窗口起始位置, hash)
+ * @note s 短于窗口时不调用回调; 总代价 O(s.size())
+ */
+template <typename F>
+inline void for_each_window(string_view s, size_t window, F f)
+{
+  if (window == 0 || s.size() < window) return;
+  rolling_hash h(window);
+  for (size_t i = 0; i < window; ++i) h.push(s[i]);
+  f(size_t{0}, h.value());
+  for (size_t i = window; i < s.size(); ++i)
+  {
+    h.roll(s[i - window], s[i]);
+    f(i - window + 1, h.value());
+  }
+}
+
+// ---------- Gear hash ----------
+namespace detail
+{
+struct gear_table_data {
+  uint64_t values[256];
+
+  gear_table_data() noexcept
+  {
+    uint64_t x = 0x2545F4914F6CDD1DULL;
+    for (uint64_t &v : values)
+    {
+      // splitmix64
+      x += 0x9E3779B97F4A7C15ULL;
+      uint64_t z = x;
+      z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+      z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+      v = z ^ (z >> 31);
+    }
+  }
+};
+}  // namespace detail
+
+// Gear hash 的 256 项随机表(首次使用时生成, 之后只读)
+inline const uint64_t *gear_table() noexcept
+{
+  static const detail::gear_table_data table;
+  return table.values;
+}
+
+// ---------- cdc_chunker 类 ----------
+class cdc_chunker
+{
+ public:
+  enum : size_t {
+    default_min_size = 2 * 1024,
+    default_avg_size = 8 * 1024,
+    default_max_size = 64 * 1024,
+  };
+
+  /**
+   * @brief 构造分块器
+   * @param min_size 最小块长度
+   * @param avg_size 期望的平均块长度, 按 2 的幂取整
+   * @param max_size 最大块长度
+   * @note 参数会被调整为 1 <= min_size <= avg_size <= max_size
+   */
+  explicit cdc_chunker(size_t min_size = default_min_size, size_t avg_size = default_avg_size,
+                       size_t max_size = default_max_size) noexcept :
+    gear_(gear_table())
+  {
+    max_size_ = std::max<size_t>(max_size, 1);
+    avg_size_ = std::min(std::max<size_t>(avg_size, 1), max_size_);
+    min_size_ = std::min(std::max<size_t>(min_size, 1), avg_size_);
+
+    unsigned bits = 0;
+    while ((size_t{2} << bits) <= avg_size_) ++bits;  // floor(log2(avg))
+    if (bits > 0 && avg_size_ - (size_t{1} << bits) >= (size_t{1} << (bits - 1))) ++bits;  // 四舍五入
+    mask_strict_ = high_bits(bits + 2);
+    mask_loose_ = high_bits(bits > 2 ? bits - 2 : 0);
+  }
+
+  size_t min_size() const noexcept
+  {
+    return min_size_;
+  }
+
+  size_t avg_size() const noexcept
+  {
+    return avg_size_;
+  }
+
+  size_t max_size() const noexcept
+  {
+    return max_size_;
+  }
+
+  /**
+   * @brief 计算 data 开头第一个块的长度
+   * @param data 输入
+   * @return 切分点; 在 max_size 之内找不到切分点且数据不足 max_size 时返回 data.size()
+   * @note 流式输入时, 返回值等于 data.size() 且小于 max_size 表示需要更多数据才能确定切分点
+   */
+  size_t cut(string_view data) const noexcept
+  {
+    const size_t n = data.size();
+    if (n <= min_size_) return n;
+    const auto *p = reinterpret_cast<const unsigned char *>(data.data());
+    const size_t normal = std::min(avg_size_, n);
+    const size_t limit = std::min(max_size_, n);
+    uint64_t h = 0;
+    size_t i = min_size_;
+    for (; i < normal; ++i)
+    {
+      h = (h << 1) + gear_[p[i]];
+      if ((h & mask_strict_) == 0) return i + 1;
+    }
+    for (; i < limit; ++i)
+    {
+      h = (h << 1) + gear_[p[i]];
+      if ((h & mask_loose_) == 0) return i + 1;
+    }
+    return limit;
+  }
+
+  /**
+   * @brief 把 data 切分为若干块, 依次调用 f(块)
+   * @param data 输入
+   * @param f 回调, 参数为指向 data 的 string_view
+   */
+  template <typename F>
+  void for_each(string_view data, F f) const
+  {
+    while (!data.empty())
+    {
+      const size_t len = cut(data);
+      f(data.substr(0, len));
+      data.remove_prefix(len);
+    }
+  }
+
+  // 把 data 切分为若干块, 每块都指向 data
+  std::vector<string_view> split(string_view data) const
+  {
+    std::vector<string_view> chunks;
+    chunks.reserve(data.size() / avg_size_ + 1);
+    for_each(data, [&chunks](string_view chunk) { chunks.push_back(chunk); });
+    return chunks;
+  }
+
+ private:
+  // 高 bits 位为 1 的掩码
+  static uint64_t high_bits(unsigned bits) noexcept
+  {
+    if (bits == 0) return 0;
+    if (bits >= 64) return ~uint64_t{0};
+    return ~uint64_t{0} << (64 - bits);
+  }
+
+  const uint64_t *gear_;
+  size_t min_size_;
+  size_t avg_size_;
+  size_t max_size_;
+  uint64_t mask_strict_;  // 块长度小于 avg 时使用
+  uint64_t mask_loose_;   // 块长度不小于 avg 时使用
+};
+
+}  // namespace abin
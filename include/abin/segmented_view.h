@@ -0,0 +1,471 @@
+/**************************************************************************************************************
+ *~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ * @file: segmented_view.h
+ * @description: 由多个不连续的 abin::string_view 片段组成的只读视图(rope), 不拷贝片段数据.
+ * - 典型场景: 网络读取得到的缓冲区链, 不必先拼接成一块连续内存再查找/比较.
+ * - 只保存片段描述(指针 + 长度)及各片段的起始偏移; 下标访问按起始偏移二分查找片段.
+ * - substr / remove_prefix / remove_suffix 只调整片段描述, 不拷贝数据.
+ * - find 先在片段内部调用 string_view::find(SIMD 内核), 跨越片段边界的匹配只可能从片段末尾
+ *   m - 1 字节内开始, 对这些候选起点原地逐段比较, 不拷贝数据; 最坏代价为 O(n + 片段数 * m^2).
+ * - hash() 与把内容拼接成连续 string_view 后的 std::hash 结果相同:
+ *   多项式 hash 满足 H(a + b) = H(a) * 131^|b| + H(b), 逐片段合并即可.
+ * - 注意: 片段引用调用者的内存, 使用期间必须保持有效.
+ *~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ **************************************************************************************************************/
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <functional>
+#include <initializer_list>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "abin/string_view.h"
+
+namespace abin
+{
+
+namespace detail
+{
+// base^e (mod 2^64), 用于合并多项式 hash
+inline size_t hash_power(size_t base, size_t e) noexcept
+{
+  size_t r = 1;
+  while (e != 0)
+  {
+    if ((e & 1) != 0) r *= base;
+    base *= base;
+    e >>= 1;
+  }
+  return r;
+}
+}  // namespace detail
+
+// ---------- segmented_view 类 ----------
+class segmented_view
+{
+ public:
+  using value_type = char;
+  using size_type = size_t;
+
+  enum : size_t { npos = static_cast<size_t>(-1) };
+
+  segmented_view() : size_(0) {}
+
+  explicit segmented_view(string_view sv) : size_(0)
+  {
+    push_back(sv);
+  }
+
+  /**
+   * @brief 由片段序列构造, 空片段会被忽略
+   * @param segments 按顺序排列的片段
+   */
+  explicit segmented_view(const std::vector<string_view> &segments) : size_(0)
+  {
+    segments_.reserve(segments.size());
+    starts_.reserve(segments.size());
+    for (string_view sv : segments) push_back(sv);
+  }
+
+  segmented_view(std::initializer_list<string_view> segments) : size_(0)
+  {
+    for (string_view sv : segments) push_back(sv);
+  }
+
+  // 在末尾追加一个片段
+  void push_back(string_view sv)
+  {
+    if (sv.empty()) return;
+    starts_.push_back(size_);
+    segments_.push_back(sv);
+    size_ += sv.size();
+  }
+
+  // ---------- 容量与片段 ----------
+  size_type size() const noexcept
+  {
+    return size_;
+  }
+
+  size_type length() const noexcept
+  {
+    return size_;
+  }
+
+  bool empty() const noexcept
+  {
+    return size_ == 0;
+  }
+
+  // 非空片段的个数
+  size_type segment_count() const noexcept
+  {
+    return segments_.size();
+  }
+
+  const std::vector<string_view> &segments() const noexcept
+  {
+    return segments_;
+  }
+
+  // 内容是否位于一块连续内存中(空视图也算连续)
+  bool contiguous() const noexcept
+  {
+    return segments_.size() <= 1;
+  }
+
+  // 连续时返回对应的 string_view, 否则返回空视图
+  string_view as_contiguous() const noexcept
+  {
+    return segments_.size() == 1 ? segments_.front() : string_view();
+  }
+
+  // ---------- 元素访问 ----------
+  char operator[](size_type pos) const noexcept
+  {
+    const size_t i = locate(pos);
+    return segments_[i][pos - starts_[i]];
+  }
+
+  char at(size_type pos) const
+  {
+    if (pos >= size_) throw std::out_of_range("abin::segmented_view::at");
+    return (*this)[pos];
+  }
+
+  char front() const noexcept
+  {
+    return segments_.front().front();
+  }
+
+  char back() const noexcept
+  {
+    return segments_.back().back();
+  }
+
+  /**
+   * @brief 拷贝子串到目标缓冲区
+   * @param dest 目标缓冲区
+   * @param count 最多拷贝的字符数
+   * @param pos 起始位置
+   * @return 实际拷贝的字符数
+   */
+  size_type copy(char *dest, size_type count, size_type pos = 0) const
+  {
+    if (pos > size_) throw std::out_of_range("abin::segmented_view::copy");
+    const size_type n = std::min(count, size_ - pos);
+    size_type done = 0;
+    if (n == 0) return 0;
+    for (size_t i = locate(pos); done < n; ++i)
+    {
+      const size_t off = (done == 0) ? pos - starts_[i] : 0;
+      const size_t take = std::min(segments_[i].size() - off, n - done);
+      std::memcpy(dest + done, segments_[i].data() + off, take);
+      done += take;
+    }
+    return n;
+  }
+
+  std::string to_string() const
+  {
+    std::string out(size_, '\0');
+    if (size_ != 0) copy(&out[0], size_);
+    return out;
+  }
+
+  // ---------- 修改视图 ----------
+  /**
+   * @brief 取子视图, 只调整片段描述, 不拷贝数据
+   * @param pos 起始位置
+   * @param count 长度(默认到末尾)
+   * @return 子视图, 可能仍由多个片段组成
+   */
+  segmented_view substr(size_type pos = 0, size_type count = npos) const
+  {
+    if (pos > size_) throw std::out_of_range("abin::segmented_view::substr");
+    const size_type n = std::min(count, size_ - pos);
+    segmented_view out;
+    if (n == 0) return out;
+    for (size_t i = locate(pos); out.size_ < n; ++i)
+    {
+      const size_t off = out.empty() ? pos - starts_[i] : 0;
+      out.push_back(segments_[i].substr(off, n - out.size_));
+    }
+    return out;
+  }
+
+  void remove_prefix(size_type n)
+  {
+    *this = substr(std::min(n, size_));
+  }
+
+  void remove_suffix(size_type n)
+  {
+    *this = substr(0, size_ - std::min(n, size_));
+  }
+
+  // ---------- 比较 ----------
+  /**
+   * @brief 按字典序比较
+   * @return 小于返回负数, 相等返回 0, 大于返回正数
+   */
+  int compare(const segmented_view &other) const noexcept
+  {
+    size_t i = 0, j = 0;    // 两侧当前片段
+    size_t oi = 0, oj = 0;  // 片段内偏移
+    while (i < segments_.size() && j < other.segments_.size())
+    {
+      const string_view a = segments_[i];
+      const string_view b = other.segments_[j];
+      const size_t take = std::min(a.size() - oi, b.size() - oj);
+      const int r = std::memcmp(a.data() + oi, b.data() + oj, take);
+      if (r != 0) return r;
+      oi += take;
+      oj += take;
+      if (oi == a.size())
+      {
+        ++i;
+        oi = 0;
+      }
+      if (oj == b.size())
+      {
+        ++j;
+        oj = 0;
+      }
+    }
+    if (size_ == other.size_) return 0;
+    return size_ < other.size_ ? -1 : 1;
+  }
+
+  int compare(string_view other) const noexcept
+  {
+    size_t done = 0;
+    for (size_t i = 0; i < segments_.size() && done < other.size(); ++i)
+    {
+      const size_t take = std::min(segments_[i].size(), other.size() - done);
+      const int r = std::memcmp(segments_[i].data(), other.data() + done, take);
+      if (r != 0) return r;
+      done += take;
+    }
+    if (size_ == other.size()) return 0;
+    return size_ < other.size() ? -1 : 1;
+  }
+
+  bool starts_with(string_view prefix) const noexcept
+  {
+    return prefix.size() <= size_ && matches_at(0, prefix);
+  }
+
+  bool ends_with(string_view suffix) const noexcept
+  {
+    return suffix.size() <= size_ && matches_at(size_ - suffix.size(), suffix);
+  }
+
+  // ---------- 查找 ----------
+  size_type find(char c, size_type pos = 0) const noexcept
+  {
+    if (pos >= size_) return npos;
+    for (size_t i = locate(pos); i < segments_.size(); ++i)
+    {
+      const size_t off = (pos > starts_[i]) ? pos - starts_[i] : 0;
+      const size_t r = segments_[i].find(c, off);
+      if (r != string_view::npos) return starts_[i] + r;
+    }
+    return npos;
+  }
+
+  /**
+   * @brief 查找子串, 匹配可以跨越任意多个片段
+   * @param needle 待查找的子串
+   * @param pos 起始位置
+   * @return 第一次出现的位置, 找不到返回 npos
+   * @note 片段内部的匹配直接用 string_view::find; 跨边界的匹配只可能从片段末尾 m - 1 字节内开始,
+   *       用 memchr 跳到首字节相同的候选起点后原地比较, 不拷贝也不分配内存
+   */
+  size_type find(string_view needle, size_type pos = 0) const noexcept
+  {
+    const size_t m = needle.size();
+    if (m == 0) return pos <= size_ ? pos : npos;
+    if (pos >= size_ || m > size_ - pos) return npos;
+    if (m == 1) return find(needle[0], pos);
+
+    for (size_t i = locate(pos); i < segments_.size(); ++i)
+    {
+      const string_view seg = segments_[i];
+      const size_t seg_start = starts_[i];
+      const size_t seg_end = seg_start + seg.size();
+      const size_t from = std::max(pos, seg_start);
+
+      const size_t inner = seg.find(needle, from - seg_start);
+      const size_t hit = (inner != string_view::npos) ? seg_start + inner : npos;
+      // 跨边界匹配的起点范围: [lo, seg_end)
+      const size_t lo = std::max(from, seg_end > m - 1 ? seg_end - (m - 1) : 0);
+      // 跨边界的候选起点还要满足在片段内匹配之前, 且匹配不越过整个视图的末尾
+      const size_t stop = std::min(std::min(seg_end, hit), size_ - m + 1);
+      for (size_t s = lo; s < stop; ++s)
+      {
+        const void *p = std::memchr(seg.data() + (s - seg_start), needle[0], stop - s);
+        if (p == nullptr) break;
+        s = seg_start + static_cast<size_t>(static_cast<const char *>(p) - seg.data());
+        const size_t head = seg_end - s;  // 落在本片段内的字节数, 1 <= head < m
+        if (std::memcmp(seg.data() + (s - seg_start), needle.data(), head) == 0 &&
+            matches_at(seg_end, string_view(needle.data() + head, m - head)))
+        {
+          return s;
+        }
+      }
+      if (hit != npos) return hit;
+    }
+    return npos;
+  }
+
+  bool contains(string_view needle) const noexcept
+  {
+    return find(needle) != npos;
+  }
+
+  bool contains(char c) const noexcept
+  {
+    return find(c) != npos;
+  }
+
+  // ---------- hash ----------
+  // 与 std::hash<abin::string_view>(to_string()) 相同, 但不拼接片段
+  size_t hash() const noexcept
+  {
+    size_t h = 0;
+    for (string_view seg : segments_)
+    {
+      h = h * detail::hash_power(131, seg.size()) + detail::polynomial_hash(seg.data(), seg.size());
+    }
+    return h;
+  }
+
+ private:
+  // 包含位置 pos 的片段下标(pos < size_)
+  size_t locate(size_type pos) const noexcept
+  {
+    return static_cast<size_t>(std::upper_bound(starts_.begin(), starts_.end(), pos) - starts_.begin()) - 1;
+  }
+
+  // [pos, pos + s.size()) 是否等于 s(调用者保证不越界)
+  bool matches_at(size_type pos, string_view s) const noexcept
+  {
+    size_t done = 0;
+    for (size_t i = s.empty() ? 0 : locate(pos); done < s.size(); ++i)
+    {
+      const size_t off = (done == 0) ? pos - starts_[i] : 0;
+      const size_t take = std::min(segments_[i].size() - off, s.size() - done);
+      if (std::memcmp(segments_[i].data() + off, s.data() + done, take) != 0) return false;
+      done += take;
+    }
+    return true;
+  }
+
+  std::vector<string_view> segments_;  // 非空片段
+  std::vector<size_t> starts_;         // starts_[i]: 第 i 个片段在整个视图中的起始偏移
+  size_t size_;
+};
+
+// ---------- 比较运算符 ----------
+inline bool operator==(const segmented_view &lhs, const segmented_view &rhs) noexcept
+{
+  return lhs.size() == rhs.size() && lhs.compare(rhs) == 0;
+}
+inline bool operator==(const segmented_view &lhs, string_view rhs) noexcept
+{
+  return lhs.size() == rhs.size() && lhs.compare(rhs) == 0;
+}
+inline bool operator==(string_view lhs, const segmented_view &rhs) noexcept
+{
+  return rhs == lhs;
+}
+
+inline bool operator!=(const segmented_view &lhs, const segmented_view &rhs) noexcept
+{
+  return !(lhs == rhs);
+}
+inline bool operator!=(const segmented_view &lhs, string_view rhs) noexcept
+{
+  return !(lhs == rhs);
+}
+inline bool operator!=(string_view lhs, const segmented_view &rhs) noexcept
+{
+  return !(rhs == lhs);
+}
+
+inline bool operator<(const segmented_view &lhs, const segmented_view &rhs) noexcept
+{
+  return lhs.compare(rhs) < 0;
+}
+inline bool operator<(const segmented_view &lhs, string_view rhs) noexcept
+{
+  return lhs.compare(rhs) < 0;
+}
+inline bool operator<(string_view lhs, const segmented_view &rhs) noexcept
+{
+  return rhs.compare(lhs) > 0;
+}
+
+inline bool operator>(const segmented_view &lhs, const segmented_view &rhs) noexcept
+{
+  return rhs < lhs;
+}
+inline bool operator>(const segmented_view &lhs, string_view rhs) noexcept
+{
+  return rhs < lhs;
+}
+inline bool operator>(string_view lhs, const segmented_view &rhs) noexcept
+{
+  return rhs < lhs;
+}
+
+inline bool operator<=(const segmented_view &lhs, const segmented_view &rhs) noexcept
+{
+  return !(rhs < lhs);
+}
+inline bool operator<=(const segmented_view &lhs, string_view rhs) noexcept
+{
+  return !(rhs < lhs);
+}
+inline bool operator<=(string_view lhs, const segmented_view &rhs) noexcept
+{
+  return !(rhs < lhs);
+}
+
+inline bool operator>=(const segmented_view &lhs, const segmented_view &rhs) noexcept
+{
+  return !(lhs < rhs);
+}
+inline bool operator>=(const segmented_view &lhs, string_view rhs) noexcept
+{
+  return !(lhs < rhs);
+}
+inline bool operator>=(string_view lhs, const segmented_view &rhs) noexcept
+{
+  return !(lhs < rhs);
+}
+
+inline std::ostream &operator<<(std::ostream &os, const segmented_view &v)
+{
+  for (string_view seg : v.segments()) os.write(seg.data(), static_cast<std::streamsize>(seg.size()));
+  return os;
+}
+
+}  // namespace abin
+
+namespace std
+{
+template <>
+struct hash<abin::segmented_view> {
+  size_t operator()(const abin::segmented_view &v) const noexcept
+  {
+    return v.hash();
+  }
+};
+}  // namespace std
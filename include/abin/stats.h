@@ -0,0 +1,429 @@
+/**************************************************************************************************************
+ *~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ * @file: stats.h
+ * @description: abin::string_view 热点操作统计(可选编译).
+ * - 编译期开关: 定义 ABIN_STRING_VIEW_ENABLE_STATS=1(CMake 选项同名)后才会在各操作中插桩;
+ *   关闭时所有插桩宏展开为空, 没有任何运行期开销, collect() 返回全 0.
+ * - 每个操作记录: 调用次数、扫描字节数(宽字符视图按代码单元计)、命中/未命中次数、命中位置的对数直方图,
+ *   以及可选的采样耗时(set_latency_sample_rate 设置每 N 次调用采样一次).
+ * - 计数器为线程局部(thread_local), 热路径上无锁、无共享写;
+ *   collect() 按需汇总所有存活线程及已退出线程的计数, reset() 通过纪元号让各线程自行清零.
+ *~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ **************************************************************************************************************/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <iomanip>
+#include <ostream>
+
+#if !defined(ABIN_STRING_VIEW_ENABLE_STATS)
+#define ABIN_STRING_VIEW_ENABLE_STATS 0
+#endif
+
+#if ABIN_STRING_VIEW_ENABLE_STATS
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <new>
+#endif
+
+namespace abin
+{
+namespace stats
+{
+
+// 被统计的操作
+enum class operation : unsigned {
+  find_char,          // find(char) / contains(char) / find_first_of(char)
+  find,               // find(string_view) / contains(string_view)
+  rfind_char,         // rfind(char)
+  rfind,              // rfind(string_view)
+  find_first_of,      // find_first_of(string_view)
+  find_first_not_of,  // find_first_not_of(char / string_view)
+  compare,            // compare / 比较运算符
+  starts_with,        // starts_with(string_view)
+  ends_with,          // ends_with(string_view)
+  substr,             // substr
+  hash,               // std::hash<abin::string_view>
+  count_              // 操作个数, 不是合法的操作
+};
+
+enum : size_t {
+  operation_count = static_cast<size_t>(operation::count_),
+  // 命中位置直方图: 桶 0 为位置 0, 桶 k 为 [2^(k-1), 2^k), 最后一个桶收纳所有更大的位置
+  position_buckets = 24
+};
+
+inline const char *operation_name(operation op) noexcept
+{
+  static const char *const names[operation_count] = {
+    "find_char", "find",        "rfind_char", "rfind",     "find_first_of", "find_first_not_of",
+    "compare",   "starts_with", "ends_with",  "substr",    "hash"};
+  const auto idx = static_cast<size_t>(op);
+  return idx < operation_count ? names[idx] : "unknown";
+}
+
+// 单个操作的统计数据
+struct op_stats {
+  uint64_t calls = 0;
+  uint64_t bytes_scanned = 0;
+  uint64_t hits = 0;    // 查找命中 / 谓词为真 / 比较相等
+  uint64_t misses = 0;  // 查找未命中 / 谓词为假 / 比较不等
+  uint64_t position_histogram[position_buckets] = {};
+  uint64_t latency_samples = 0;
+  uint64_t latency_total_ns = 0;
+  uint64_t latency_max_ns = 0;
+};
+
+// 所有操作的统计快照
+struct snapshot {
+  op_stats ops[operation_count];
+
+  const op_stats &operator[](operation op) const noexcept
+  {
+    return ops[static_cast<size_t>(op)];
+  }
+  op_stats &operator[](operation op) noexcept
+  {
+    return ops[static_cast<size_t>(op)];
+  }
+};
+
+// 编译期开关是否打开
+inline constexpr bool enabled() noexcept
+{
+  return ABIN_STRING_VIEW_ENABLE_STATS != 0;
+}
+
+// 命中位置所属的直方图桶
+inline size_t position_bucket(size_t pos) noexcept
+{
+  size_t bucket = 0;
+  while (pos != 0 && bucket + 1 < position_buckets)
+  {
+    pos >>= 1;
+    ++bucket;
+  }
+  return bucket;
+}
+
+#if ABIN_STRING_VIEW_ENABLE_STATS
+namespace detail
+{
+
+// 线程局部计数块. 只有所属线程写入(relaxed load + store, 不需要原子读改写),
+// 汇总线程通过 relaxed load 读取.
+struct thread_block {
+  struct counters {
+    std::atomic<uint64_t> calls{0};
+    std::atomic<uint64_t> bytes_scanned{0};
+    std::atomic<uint64_t> hits{0};
+    std::atomic<uint64_t> misses{0};
+    std::atomic<uint64_t> position_histogram[position_buckets];
+    std::atomic<uint64_t> latency_samples{0};
+    std::atomic<uint64_t> latency_total_ns{0};
+    std::atomic<uint64_t> latency_max_ns{0};
+
+    counters() noexcept
+    {
+      for (auto &h : position_histogram) h.store(0, std::memory_order_relaxed);
+    }
+  };
+
+  counters ops[operation_count];
+  std::atomic<uint64_t> epoch{0};  // 计数所属的 reset 纪元
+  uint32_t sample_countdown = 0;   // 距离下一次耗时采样还剩的调用次数
+  thread_block *prev = nullptr;    // 登记表中的侵入式双向链表, 登记与注销都不需要分配内存
+  thread_block *next = nullptr;
+
+  thread_block() noexcept;
+  ~thread_block();
+  thread_block(const thread_block &) = delete;
+  thread_block &operator=(const thread_block &) = delete;
+
+  void clear() noexcept
+  {
+    for (auto &c : ops)
+    {
+      c.calls.store(0, std::memory_order_relaxed);
+      c.bytes_scanned.store(0, std::memory_order_relaxed);
+      c.hits.store(0, std::memory_order_relaxed);
+      c.misses.store(0, std::memory_order_relaxed);
+      for (auto &h : c.position_histogram) h.store(0, std::memory_order_relaxed);
+      c.latency_samples.store(0, std::memory_order_relaxed);
+      c.latency_total_ns.store(0, std::memory_order_relaxed);
+      c.latency_max_ns.store(0, std::memory_order_relaxed);
+    }
+  }
+
+  void add_to(snapshot &out) const noexcept
+  {
+    for (size_t i = 0; i < operation_count; ++i)
+    {
+      const counters &c = ops[i];
+      op_stats &o = out.ops[i];
+      o.calls += c.calls.load(std::memory_order_relaxed);
+      o.bytes_scanned += c.bytes_scanned.load(std::memory_order_relaxed);
+      o.hits += c.hits.load(std::memory_order_relaxed);
+      o.misses += c.misses.load(std::memory_order_relaxed);
+      for (size_t b = 0; b < position_buckets; ++b)
+      {
+        o.position_histogram[b] += c.position_histogram[b].load(std::memory_order_relaxed);
+      }
+      o.latency_samples += c.latency_samples.load(std::memory_order_relaxed);
+      o.latency_total_ns += c.latency_total_ns.load(std::memory_order_relaxed);
+      o.latency_max_ns = std::max(o.latency_max_ns, c.latency_max_ns.load(std::memory_order_relaxed));
+    }
+  }
+};
+
+// 全局登记表: 存活线程的计数块 + 已退出线程的累计值
+struct registry {
+  std::mutex mutex;
+  thread_block *head = nullptr;  // 存活线程的计数块链表
+  snapshot retired;
+  std::atomic<uint64_t> epoch{0};
+  std::atomic<uint32_t> sample_rate{0};  // 每 N 次调用采样一次耗时, 0 表示关闭
+
+  static registry &instance() noexcept
+  {
+    // 有意不析构: 保证在其他线程的 thread_local 析构(可能晚于静态对象析构)时仍然可用.
+    // 构造在静态存储上而非堆上, 线程首次被插桩的操作不会因分配失败而终止
+    alignas(registry) static unsigned char storage[sizeof(registry)];
+    static registry *r = new (storage) registry();
+    return *r;
+  }
+};
+
+inline thread_block::thread_block() noexcept
+{
+  registry &r = registry::instance();
+  epoch.store(r.epoch.load(std::memory_order_acquire), std::memory_order_relaxed);
+  std::lock_guard<std::mutex> lock(r.mutex);
+  next = r.head;
+  if (next != nullptr) next->prev = this;
+  r.head = this;
+}
+
+inline thread_block::~thread_block()
+{
+  registry &r = registry::instance();
+  std::lock_guard<std::mutex> lock(r.mutex);
+  if (epoch.load(std::memory_order_relaxed) == r.epoch.load(std::memory_order_relaxed)) add_to(r.retired);
+  (prev != nullptr ? prev->next : r.head) = next;
+  if (next != nullptr) next->prev = prev;
+}
+
+inline thread_block &local_block() noexcept
+{
+  static thread_local thread_block block;
+  return block;
+}
+
+template <typename T>
+inline void bump(std::atomic<T> &counter, T delta) noexcept
+{
+  counter.store(counter.load(std::memory_order_relaxed) + delta, std::memory_order_relaxed);
+}
+
+// 插桩探针: 构造时决定是否采样耗时, 通过 search / predicate / scan 记录结果并原样返回
+class probe
+{
+ public:
+  explicit probe(operation op) noexcept : block_(local_block()), op_(op), sampled_(false)
+  {
+    registry &r = registry::instance();
+    const uint64_t global_epoch = r.epoch.load(std::memory_order_acquire);
+    if (block_.epoch.load(std::memory_order_relaxed) != global_epoch)
+    {
+      block_.clear();
+      block_.epoch.store(global_epoch, std::memory_order_release);
+    }
+    const uint32_t rate = r.sample_rate.load(std::memory_order_relaxed);
+    if (rate != 0)
+    {
+      if (block_.sample_countdown == 0 || block_.sample_countdown > rate)
+      {
+        block_.sample_countdown = rate;
+        sampled_ = true;
+        start_ = std::chrono::steady_clock::now();
+      }
+      --block_.sample_countdown;
+    }
+  }
+
+  ~probe()
+  {
+    if (!sampled_) return;
+    const auto ns = static_cast<uint64_t>(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start_).count());
+    thread_block::counters &c = counters_();
+    bump<uint64_t>(c.latency_samples, 1);
+    bump<uint64_t>(c.latency_total_ns, ns);
+    if (ns > c.latency_max_ns.load(std::memory_order_relaxed)) c.latency_max_ns.store(ns, std::memory_order_relaxed);
+  }
+
+  probe(const probe &) = delete;
+  probe &operator=(const probe &) = delete;
+
+  // 查找类操作: pos == npos 视为未命中, 否则按位置计入直方图
+  size_t search(size_t pos, size_t bytes) noexcept
+  {
+    thread_block::counters &c = count(bytes);
+    if (pos == static_cast<size_t>(-1))
+    {
+      bump<uint64_t>(c.misses, 1);
+    }
+    else
+    {
+      bump<uint64_t>(c.hits, 1);
+      bump<uint64_t>(c.position_histogram[position_bucket(pos)], 1);
+    }
+    return pos;
+  }
+
+  // 谓词类操作: true 计为命中
+  bool predicate(bool result, size_t bytes) noexcept
+  {
+    thread_block::counters &c = count(bytes);
+    bump<uint64_t>(result ? c.hits : c.misses, 1);
+    return result;
+  }
+
+  // 比较操作: 相等计为命中
+  int comparison(int result, size_t bytes) noexcept
+  {
+    predicate(result == 0, bytes);
+    return result;
+  }
+
+  // 只统计调用次数与字节数
+  template <typename T>
+  T scan(T result, size_t bytes) noexcept
+  {
+    count(bytes);
+    return result;
+  }
+
+ private:
+  thread_block::counters &counters_() noexcept
+  {
+    return block_.ops[static_cast<size_t>(op_)];
+  }
+
+  thread_block::counters &count(size_t bytes) noexcept
+  {
+    thread_block::counters &c = counters_();
+    bump<uint64_t>(c.calls, 1);
+    bump<uint64_t>(c.bytes_scanned, static_cast<uint64_t>(bytes));
+    return c;
+  }
+
+  thread_block &block_;
+  operation op_;
+  bool sampled_;
+  std::chrono::steady_clock::time_point start_;
+};
+
+}  // namespace detail
+#endif
+
+/**
+ * @brief 汇总所有线程(含已退出线程)自上次 reset() 以来的统计数据
+ * @return 统计快照; 编译期开关关闭时返回全 0
+ */
+inline snapshot collect()
+{
+  snapshot out;
+#if ABIN_STRING_VIEW_ENABLE_STATS
+  detail::registry &r = detail::registry::instance();
+  std::lock_guard<std::mutex> lock(r.mutex);
+  const uint64_t epoch = r.epoch.load(std::memory_order_acquire);
+  out = r.retired;
+  for (const detail::thread_block *b = r.head; b != nullptr; b = b->next)
+  {
+    // 纪元落后的线程尚未清零, 其计数属于上一轮, 不计入
+    if (b->epoch.load(std::memory_order_acquire) == epoch) b->add_to(out);
+  }
+#endif
+  return out;
+}
+
+/**
+ * @brief 清零统计数据
+ * @note 各线程在下一次被插桩的操作中自行清零自己的计数块, 不与热路径竞争
+ */
+inline void reset()
+{
+#if ABIN_STRING_VIEW_ENABLE_STATS
+  detail::registry &r = detail::registry::instance();
+  std::lock_guard<std::mutex> lock(r.mutex);
+  r.retired = snapshot();
+  r.epoch.fetch_add(1, std::memory_order_acq_rel);
+#endif
+}
+
+/**
+ * @brief 设置耗时采样频率
+ * @param every_n 每个线程每 every_n 次被插桩的调用采样一次耗时, 0 表示关闭(默认)
+ */
+inline void set_latency_sample_rate(uint32_t every_n) noexcept
+{
+#if ABIN_STRING_VIEW_ENABLE_STATS
+  detail::registry::instance().sample_rate.store(every_n, std::memory_order_relaxed);
+#else
+  (void)every_n;
+#endif
+}
+
+/**
+ * @brief 以文本表格形式输出统计快照, 只输出被调用过的操作
+ */
+inline void dump(std::ostream &os, const snapshot &s)
+{
+  os << std::left << std::setw(18) << "operation" << std::right << std::setw(14) << "calls" << std::setw(16)
+     << "bytes" << std::setw(14) << "hits" << std::setw(14) << "misses" << std::setw(14) << "avg_ns(sampled)"
+     << '\n';
+  for (size_t i = 0; i < operation_count; ++i)
+  {
+    const op_stats &o = s.ops[i];
+    if (o.calls == 0) continue;
+    const double avg_ns =
+      o.latency_samples != 0 ? static_cast<double>(o.latency_total_ns) / static_cast<double>(o.latency_samples) : 0.0;
+    os << std::left << std::setw(18) << operation_name(static_cast<operation>(i)) << std::right << std::setw(14)
+       << o.calls << std::setw(16) << o.bytes_scanned << std::setw(14) << o.hits << std::setw(14) << o.misses
+       << std::setw(14) << avg_ns << '\n';
+  }
+}
+
+// 汇总并输出当前统计数据
+inline void dump(std::ostream &os)
+{
+  dump(os, collect());
+}
+
+}  // namespace stats
+}  // namespace abin
+
+// ---------- 插桩宏(库内部使用) ----------
+// ABIN_SV_STATS_SCOPE(op)            : 在函数开头声明探针
+// ABIN_SV_STATS_SEARCH(pos, bytes)   : 记录查找结果并返回 pos
+// ABIN_SV_STATS_PREDICATE(b, bytes)  : 记录谓词结果并返回 b
+// ABIN_SV_STATS_COMPARE(r, bytes)    : 记录比较结果并返回 r
+// ABIN_SV_STATS_SCAN(v, bytes)       : 只记录字节数并返回 v
+#if ABIN_STRING_VIEW_ENABLE_STATS
+#define ABIN_SV_STATS_SCOPE(op) ::abin::stats::detail::probe abin_sv_stats_probe_(::abin::stats::operation::op)
+#define ABIN_SV_STATS_SEARCH(pos, bytes) abin_sv_stats_probe_.search((pos), (bytes))
+#define ABIN_SV_STATS_PREDICATE(b, bytes) abin_sv_stats_probe_.predicate((b), (bytes))
+#define ABIN_SV_STATS_COMPARE(r, bytes) abin_sv_stats_probe_.comparison((r), (bytes))
+#define ABIN_SV_STATS_SCAN(v, bytes) abin_sv_stats_probe_.scan((v), (bytes))
+#else
+#define ABIN_SV_STATS_SCOPE(op) static_cast<void>(0)
+#define ABIN_SV_STATS_SEARCH(pos, bytes) (pos)
+#define ABIN_SV_STATS_PREDICATE(b, bytes) (b)
+#define ABIN_SV_STATS_COMPARE(r, bytes) (r)
+#define ABIN_SV_STATS_SCAN(v, bytes) (v)
+#endif
@@ -6,11 +6,17 @@
  * - Design Philosophy :
  *   - Non-owning: Does not manage string memory, only holds a pointer and length for lightweight usage.
  *   - Zero-copy access: Operates directly on existing string data without additional allocations or copies.
- *   - Lightweight & Efficient: Internally uses only `const char*` and `size_t`, with minimal overhead.
+ *   - Lightweight & Efficient: Internally uses only `const CharT*` and `size_t`, with minimal overhead.
+ *   - Character types: `basic_string_view<CharT, Traits>` with `string_view`, `wstring_view`,
+ *     `u16string_view` and `u32string_view` aliases; 16/32-bit code units use SIMD find/compare kernels.
  *   - Safe & Convenient: Provides bounds-checked access via `at()` and rich operations like search,
  *     comparison, and substring.
  *   - Standard-friendly: Seamlessly integrates with `std::ostream` for direct output.
  *   - Hash support: Provides `std::hash` specialization for use in `unordered_map` and `unordered_set`.
+ *   - Runtime dispatch: Search kernels (SSE2/AVX2) are selected at runtime from the detected CPU
+ *     features (see `abin/dispatch.h`).
+ *   - Optional statistics: Define `ABIN_STRING_VIEW_ENABLE_STATS=1` to record per-operation counters
+ *     (see `abin/stats.h`); zero cost when disabled.
  *
  * @author: abin
  * @date: 2026-01-12
@@ -23,20 +29,203 @@
 
 #include <algorithm>
 #include <cstddef>
+#include <cstdint>
 #include <ostream>
 #include <stdexcept>
 #include <string>
+#include <type_traits>
 #include <utility>
 
+#include "abin/dispatch.h"
+#include "abin/stats.h"
+
 namespace abin
 {
 
-// ---------- string_view 类 ----------
-class string_view  // NOLINT(cppcoreguidelines-special-member-functions)
+namespace detail
+{
+
+// 阻止模板实参推导, 使比较运算符的一侧可以隐式转换(如 sv == "abc")
+template <typename T>
+struct identity {
+  using type = T;
+};
+
+// ---------- 查找/比较算法 ----------
+// 所有函数返回相对 s 的偏移, 找不到返回 kernel_npos.
+// 通用版本只依赖 Traits; char 与 16/32 位代码单元(使用 std::char_traits 时)特化为 SIMD 内核.
+template <typename CharT, typename Traits>
+struct generic_sv_algorithms {
+  static size_t find_char(const CharT *s, size_t n, CharT c) noexcept
+  {
+    if (n == 0) return kernel_npos;
+    const CharT *p = Traits::find(s, n, c);
+    return p != nullptr ? static_cast<size_t>(p - s) : kernel_npos;
+  }
+
+  static size_t rfind_char(const CharT *s, size_t n, CharT c) noexcept
+  {
+    for (size_t i = n; i-- > 0;)
+    {
+      if (Traits::eq(s[i], c)) return i;
+    }
+    return kernel_npos;
+  }
+
+  static size_t find(const CharT *s, size_t n, const CharT *needle, size_t m) noexcept
+  {
+    if (m == 0) return 0;
+    if (m > n) return kernel_npos;
+    const size_t last_start = n - m;
+    for (size_t i = 0; i <= last_start; ++i)
+    {
+      const size_t hit = find_char(s + i, last_start - i + 1, needle[0]);
+      if (hit == kernel_npos) return kernel_npos;
+      i += hit;
+      if (Traits::compare(s + i + 1, needle + 1, m - 1) == 0) return i;
+    }
+    return kernel_npos;
+  }
+
+  static size_t find_first_of(const CharT *s, size_t n, const CharT *set, size_t k) noexcept
+  {
+    if (k == 0) return kernel_npos;
+    for (size_t i = 0; i < n; ++i)
+    {
+      if (Traits::find(set, k, s[i]) != nullptr) return i;
+    }
+    return kernel_npos;
+  }
+
+  static int compare(const CharT *a, const CharT *b, size_t n) noexcept
+  {
+    return n != 0 ? Traits::compare(a, b, n) : 0;
+  }
+};
+
+template <typename CharT, typename Traits>
+struct sv_algorithms : generic_sv_algorithms<CharT, Traits> {};
+
+template <>
+struct sv_algorithms<char, std::char_traits<char>> : generic_sv_algorithms<char, std::char_traits<char>> {
+  static size_t find_char(const char *s, size_t n, char c) noexcept
+  {
+    return dispatch::kernels::find_char()(s, n, c);
+  }
+  static size_t rfind_char(const char *s, size_t n, char c) noexcept
+  {
+    return dispatch::kernels::rfind_char()(s, n, c);
+  }
+  static size_t find(const char *s, size_t n, const char *needle, size_t m) noexcept
+  {
+    return dispatch::kernels::find()(s, n, needle, m);
+  }
+  static size_t find_first_of(const char *s, size_t n, const char *set, size_t k) noexcept
+  {
+    return dispatch::kernels::find_first_of()(s, n, set, k);
+  }
+};
+
+// 按代码单元宽度选择宽字符内核
+template <size_t Width>
+struct unit_kernels;
+
+template <>
+struct unit_kernels<2> {
+  static dispatch::detail::find_unit_fn find_char() noexcept
+  {
+    return dispatch::kernels::find_char16();
+  }
+  static dispatch::detail::find_units_fn find() noexcept
+  {
+    return dispatch::kernels::find16();
+  }
+};
+
+template <>
+struct unit_kernels<4> {
+  static dispatch::detail::find_unit_fn find_char() noexcept
+  {
+    return dispatch::kernels::find_char32();
+  }
+  static dispatch::detail::find_units_fn find() noexcept
+  {
+    return dispatch::kernels::find32();
+  }
+};
+
+// 16/32 位代码单元: find 使用向量化内核; compare 先找第一个不等字节, 再按 Traits::lt 比较该代码单元
+template <typename CharT>
+struct wide_sv_algorithms : generic_sv_algorithms<CharT, std::char_traits<CharT>> {
+  using kernels = unit_kernels<sizeof(CharT)>;
+  using unit_type = typename std::conditional<sizeof(CharT) == 2, uint16_t, uint32_t>::type;
+
+  static size_t find_char(const CharT *s, size_t n, CharT c) noexcept
+  {
+    return kernels::find_char()(s, n, static_cast<unit_type>(c));
+  }
+  static size_t find(const CharT *s, size_t n, const CharT *needle, size_t m) noexcept
+  {
+    return kernels::find()(s, n, needle, m);
+  }
+  static int compare(const CharT *a, const CharT *b, size_t n) noexcept
+  {
+    const size_t i = dispatch::kernels::mismatch()(a, b, n * sizeof(CharT)) / sizeof(CharT);
+    if (i >= n) return 0;
+    return std::char_traits<CharT>::lt(a[i], b[i]) ? -1 : 1;
+  }
+};
+
+template <>
+struct sv_algorithms<char16_t, std::char_traits<char16_t>> : wide_sv_algorithms<char16_t> {};
+
+template <>
+struct sv_algorithms<char32_t, std::char_traits<char32_t>> : wide_sv_algorithms<char32_t> {};
+
+template <>
+struct sv_algorithms<wchar_t, std::char_traits<wchar_t>> :
+  std::conditional<sizeof(wchar_t) == 2 || sizeof(wchar_t) == 4, wide_sv_algorithms<wchar_t>,
+                   generic_sv_algorithms<wchar_t, std::char_traits<wchar_t>>>::type {};
+
+/**
+ * @brief 计算 h = h * 131 + c 多项式哈希(c 为无符号代码单元)
+ * @note 逐个代码单元累乘时每一步都依赖上一步的乘法结果, 吞吐受乘法延迟限制.
+ *       这里把前 8k 个代码单元拆成 8 条互不依赖的乘加链(每条链的乘数为 131^8),
+ *       最后按 131 的幂次合并, 结果与逐个累乘完全一致.
+ */
+template <typename CharT>
+inline size_t polynomial_hash(const CharT *p, size_t n) noexcept
 {
+  using unit = typename std::make_unsigned<CharT>::type;
+  const size_t base = 131;
+  const CharT *const end = p + n;
+  size_t h = 0;
+  if (n >= 16)
+  {
+    size_t base8 = 1;
+    for (int k = 0; k < 8; ++k) base8 *= base;
+    size_t lane[8] = {0, 0, 0, 0, 0, 0, 0, 0};
+    for (const CharT *const head_end = p + (n & ~static_cast<size_t>(7)); p != head_end; p += 8)
+    {
+      for (size_t j = 0; j < 8; ++j) lane[j] = lane[j] * base8 + static_cast<size_t>(static_cast<unit>(p[j]));
+    }
+    for (size_t j = 0; j < 8; ++j) h = h * base + lane[j];
+  }
+  for (; p != end; ++p) h = h * base + static_cast<size_t>(static_cast<unit>(*p));
+  return h;
+}
+
+}  // namespace detail
+
+// ---------- basic_string_view 类 ----------
+template <typename CharT, typename Traits = std::char_traits<CharT>>
+class basic_string_view  // NOLINT(cppcoreguidelines-special-member-functions)
+{
+  using algorithms = detail::sv_algorithms<CharT, Traits>;
+
  public:
-  using traits_type = std::char_traits<char>;  // 目前仅支持 char 类型
-  using value_type = char;                     // 目前仅支持 char 类型
+  using traits_type = Traits;
+  using value_type = CharT;
   using pointer = value_type *;
   using const_pointer = const value_type *;
   using reference = value_type &;
@@ -62,23 +251,25 @@ class string_view  // NOLINT(cppcoreguidelines-special-member-functions)
 
  public:
   // ---------- 构造 ----------
-  string_view() noexcept : data_(nullptr), size_(0) {}
+  basic_string_view() noexcept : data_(nullptr), size_(0) {}
 
   // Precondition: str != nullptr
-  string_view(const char *str, size_type len) noexcept : data_(str), size_(len) {}
-  string_view(const char *str) :  // NOLINT(google-explicit-constructor)
+  basic_string_view(const CharT *str, size_type len) noexcept : data_(str), size_(len) {}
+  basic_string_view(const CharT *str) :  // NOLINT(google-explicit-constructor)
     data_(str), size_((str != nullptr) ? traits_type::length(str) : 0)
   {}
 
-  string_view(const std::string &str) noexcept :  // NOLINT(google-explicit-constructor)
+  template <typename Allocator>
+  // NOLINTNEXTLINE(google-explicit-constructor)
+  basic_string_view(const std::basic_string<CharT, Traits, Allocator> &str) noexcept :
     data_(str.data()), size_(str.size())
   {}
 
-  string_view(const string_view &) noexcept = default;
-  string_view(std::nullptr_t) = delete;
+  basic_string_view(const basic_string_view &) noexcept = default;
+  basic_string_view(std::nullptr_t) = delete;
 
-  string_view &operator=(const string_view &) noexcept = default;
-  ~string_view() = default;
+  basic_string_view &operator=(const basic_string_view &) noexcept = default;
+  ~basic_string_view() = default;
 
   // ---------- Capacity ----------
   size_type size() const noexcept
@@ -127,7 +318,7 @@ class string_view  // NOLINT(cppcoreguidelines-special-member-functions)
   }
 
   // ---------- Operations ----------
-  size_type copy(char *dest, size_type count, size_type pos = 0) const
+  size_type copy(CharT *dest, size_type count, size_type pos = 0) const
   {
     if (pos > size_) throw std::out_of_range("abin::string_view::copy");
     size_type rcount = std::min(count, size_ - pos);
@@ -138,55 +329,57 @@ class string_view  // NOLINT(cppcoreguidelines-special-member-functions)
     return rcount;
   }
 
-  string_view substr(size_type pos, size_type count = string_view::npos) const
+  basic_string_view substr(size_type pos, size_type count = npos) const
   {
+    ABIN_SV_STATS_SCOPE(substr);
     if (pos > size_) throw std::out_of_range("abin::string_view::substr");
     count = std::min(count, size_ - pos);
-    return {data_ + pos, count};
+    return ABIN_SV_STATS_SCAN(basic_string_view(data_ + pos, count), 0);  // 只调整指针与长度, 不扫描数据
   }
 
-  // 与另一个 string_view 比较
-  int compare(string_view other) const noexcept
+  // 与另一个 basic_string_view 比较
+  int compare(basic_string_view other) const noexcept
   {
+    ABIN_SV_STATS_SCOPE(compare);
     size_type min_len = std::min(size_, other.size_);
-    int r = traits_type::compare(data_, other.data_, min_len);
-    if (r != 0) return r;
-    if (size_ < other.size_) return -1;
-    if (size_ > other.size_) return 1;
-    return 0;
+    int r = algorithms::compare(data_, other.data_, min_len);
+    if (r != 0) return ABIN_SV_STATS_COMPARE(r, min_len);
+    if (size_ < other.size_) return ABIN_SV_STATS_COMPARE(-1, min_len);
+    if (size_ > other.size_) return ABIN_SV_STATS_COMPARE(1, min_len);
+    return ABIN_SV_STATS_COMPARE(0, min_len);
   }
 
   // 与 C 字符串比较
-  int compare(const char *s) const
+  int compare(const CharT *s) const
   {
-    string_view sv(s);  // 利用已有的 string_view(const char*)
+    basic_string_view sv(s);  // 利用已有的 basic_string_view(const CharT*)
     return compare(sv);
   }
 
   // 子串比较
-  int compare(size_type pos1, size_type count1, string_view sv) const
+  int compare(size_type pos1, size_type count1, basic_string_view sv) const
   {
     if (pos1 > size_) throw std::out_of_range("abin::string_view::compare");
-    string_view sub1 = substr(pos1, count1);
+    basic_string_view sub1 = substr(pos1, count1);
     return sub1.compare(sv);
   }
 
-  int compare(size_type pos1, size_type count1, string_view sv, size_type pos2, size_type count2) const
+  int compare(size_type pos1, size_type count1, basic_string_view sv, size_type pos2, size_type count2) const
   {
     if (pos1 > size_) throw std::out_of_range("abin::string_view::compare");
-    string_view sub1 = substr(pos1, count1);
-    string_view sub2 = sv.substr(pos2, count2);
+    basic_string_view sub1 = substr(pos1, count1);
+    basic_string_view sub2 = sv.substr(pos2, count2);
     return sub1.compare(sub2);
   }
 
-  int compare(size_type pos1, size_type count1, const char *s) const
+  int compare(size_type pos1, size_type count1, const CharT *s) const
   {
-    return compare(pos1, count1, string_view(s));
+    return compare(pos1, count1, basic_string_view(s));
   }
 
-  int compare(size_type pos1, size_type count1, const char *s, size_type n) const
+  int compare(size_type pos1, size_type count1, const CharT *s, size_type n) const
   {
-    return compare(pos1, count1, string_view(s, n));
+    return compare(pos1, count1, basic_string_view(s, n));
   }
 
   /**
@@ -198,12 +391,11 @@ class string_view  // NOLINT(cppcoreguidelines-special-member-functions)
    */
   size_type find(value_type c, size_type pos = 0) const noexcept
   {
-    if (pos >= size_) return npos;
-    for (size_type i = pos; i < size_; ++i)
-    {
-      if (data_[i] == c) return i;
-    }
-    return npos;
+    ABIN_SV_STATS_SCOPE(find_char);
+    if (pos >= size_) return ABIN_SV_STATS_SEARCH(npos, 0);
+    const size_type r = algorithms::find_char(data_ + pos, size_ - pos, c);
+    if (r != npos) return ABIN_SV_STATS_SEARCH(pos + r, r + 1);
+    return ABIN_SV_STATS_SEARCH(npos, size_ - pos);
   }
 
   /**
@@ -214,17 +406,16 @@ class string_view  // NOLINT(cppcoreguidelines-special-member-functions)
    * @note 空子串总是匹配当前位置, 如果 pos == size(), 也返回 size()
    * @note 如果 pos > size() 或剩余长度不足以匹配子串, 则返回 npos
    */
-  size_type find(string_view sv, size_type pos = 0) const noexcept
+  size_type find(basic_string_view sv, size_type pos = 0) const noexcept
   {
-    if (pos > size_) return npos;             // 越界检查
-    if (sv.size_ == 0) return pos;            // 空子串匹配当前位置
-    if (sv.size_ > size_ - pos) return npos;  // 剩余长度不足
+    ABIN_SV_STATS_SCOPE(find);
+    if (pos > size_) return ABIN_SV_STATS_SEARCH(npos, 0);             // 越界检查
+    if (sv.size_ == 0) return ABIN_SV_STATS_SEARCH(pos, 0);            // 空子串匹配当前位置
+    if (sv.size_ > size_ - pos) return ABIN_SV_STATS_SEARCH(npos, 0);  // 剩余长度不足
 
-    for (size_type i = pos; i <= size_ - sv.size_; ++i)
-    {
-      if (traits_type::compare(data_ + i, sv.data_, sv.size_) == 0) return i;
-    }
-    return npos;
+    const size_type r = algorithms::find(data_ + pos, size_ - pos, sv.data_, sv.size_);
+    if (r != npos) return ABIN_SV_STATS_SEARCH(pos + r, r + sv.size_);
+    return ABIN_SV_STATS_SEARCH(npos, size_ - pos);
   }
 
   /**
@@ -235,9 +426,9 @@ class string_view  // NOLINT(cppcoreguidelines-special-member-functions)
    * @return 返回首次匹配的起始位置, 如果找不到则返回 npos
    * @note 直接包装 string_view 查找逻辑
    */
-  size_type find(const char *s, size_type pos, size_type n) const
+  size_type find(const CharT *s, size_type pos, size_type n) const
   {
-    return find(string_view(s, n), pos);
+    return find(basic_string_view(s, n), pos);
   }
 
   /**
@@ -247,9 +438,9 @@ class string_view  // NOLINT(cppcoreguidelines-special-member-functions)
    * @return 返回首次匹配的起始位置, 如果找不到则返回 npos
    * @note 直接包装 string_view 查找逻辑
    */
-  size_type find(const char *s, size_type pos = 0) const
+  size_type find(const CharT *s, size_type pos = 0) const
   {
-    return find(string_view(s), pos);
+    return find(basic_string_view(s), pos);
   }
 
   /**
@@ -261,15 +452,13 @@ class string_view  // NOLINT(cppcoreguidelines-special-member-functions)
    */
   size_type rfind(value_type c, size_type pos = npos) const noexcept
   {
-    if (size_ == 0) return npos;
+    ABIN_SV_STATS_SCOPE(rfind_char);
+    if (size_ == 0) return ABIN_SV_STATS_SEARCH(npos, 0);
     // 如果 pos 超过末尾, 取末尾位置
     if (pos >= size_) pos = size_ - 1;
-    for (size_type i = pos + 1; i-- > 0;)  // 注意 i-- > 0 防止溢出
-    {
-      if (data_[i] == c) return i;
-      if (i == 0) break;  // 防止无符号 size_type 变为最大值
-    }
-    return npos;
+    const size_type r = algorithms::rfind_char(data_, pos + 1, c);
+    if (r != npos) return ABIN_SV_STATS_SEARCH(r, pos - r + 1);
+    return ABIN_SV_STATS_SEARCH(npos, pos + 1);
   }
 
   /**
@@ -279,20 +468,27 @@ class string_view  // NOLINT(cppcoreguidelines-special-member-functions)
    * @return 返回最后一次匹配的起始位置, 如果找不到返回 npos
    * @note 空子串总是匹配当前位置, 如果 pos >= size(), 从 size() 开始
    */
-  size_type rfind(string_view sv, size_type pos = npos) const noexcept
+  size_type rfind(basic_string_view sv, size_type pos = npos) const noexcept
   {
-    if (sv.size_ == 0) return std::min(pos, size_);  // 空子串匹配当前位置
-    if (sv.size_ > size_) return npos;               // 子串比主串长 → 不可能匹配
+    ABIN_SV_STATS_SCOPE(rfind);
+    if (sv.size_ == 0) return ABIN_SV_STATS_SEARCH(std::min(pos, size_), 0);  // 空子串匹配当前位置
+    if (sv.size_ > size_) return ABIN_SV_STATS_SEARCH(npos, 0);               // 子串比主串长 → 不可能匹配
 
     // 搜索起始位置
     pos = std::min(pos, size_ - sv.size_);
 
-    for (size_type i = pos + 1; i-- > 0;)  // 从 pos 向前查找
+    // 从 pos 向前: 先用 rfind_char 内核跳到首字符的上一个出现位置, 再比较整个子串
+    for (size_type end = pos + 1; end > 0;)
     {
-      if (traits_type::compare(data_ + i, sv.data_, sv.size_) == 0) return i;
-      if (i == 0) break;  // 防止 size_type 溢出
+      const size_type i = algorithms::rfind_char(data_, end, sv.data_[0]);
+      if (i == npos) break;
+      if (algorithms::compare(data_ + i, sv.data_, sv.size_) == 0)
+      {
+        return ABIN_SV_STATS_SEARCH(i, pos - i + sv.size_);
+      }
+      end = i;
     }
-    return npos;
+    return ABIN_SV_STATS_SEARCH(npos, pos + sv.size_);
   }
 
   /**
@@ -302,9 +498,9 @@ class string_view  // NOLINT(cppcoreguidelines-special-member-functions)
    * @param n s 的长度
    * @return 返回最后一次匹配的起始位置, 如果找不到返回 npos
    */
-  size_type rfind(const char *s, size_type pos, size_type n) const noexcept
+  size_type rfind(const CharT *s, size_type pos, size_type n) const noexcept
   {
-    return rfind(string_view(s, n), pos);
+    return rfind(basic_string_view(s, n), pos);
   }
 
   /**
@@ -313,9 +509,9 @@ class string_view  // NOLINT(cppcoreguidelines-special-member-functions)
    * @param pos 起始位置(默认 size() - 1)
    * @return 返回最后一次匹配的起始位置, 如果找不到返回 npos
    */
-  size_type rfind(const char *s, size_type pos = npos) const noexcept
+  size_type rfind(const CharT *s, size_type pos = npos) const noexcept
   {
-    return rfind(string_view(s), pos);
+    return rfind(basic_string_view(s), pos);
   }
 
   /**
@@ -338,14 +534,13 @@ class string_view  // NOLINT(cppcoreguidelines-special-member-functions)
    * @note 如果 pos >= size(), 直接返回 npos
    * @note 如果 sv 为空, 则永远返回 npos
    */
-  size_type find_first_of(string_view sv, size_type pos = 0) const noexcept
+  size_type find_first_of(basic_string_view sv, size_type pos = 0) const noexcept
   {
-    if (pos >= size_) return npos;
-    for (size_type i = pos; i < size_; ++i)
-    {
-      if (sv.find(data_[i]) != npos) return i;
-    }
-    return npos;
+    ABIN_SV_STATS_SCOPE(find_first_of);
+    if (pos >= size_) return ABIN_SV_STATS_SEARCH(npos, 0);
+    const size_type r = algorithms::find_first_of(data_ + pos, size_ - pos, sv.data_, sv.size_);
+    if (r != npos) return ABIN_SV_STATS_SEARCH(pos + r, r + 1);
+    return ABIN_SV_STATS_SEARCH(npos, size_ - pos);
   }
 
   /**
@@ -356,9 +551,9 @@ class string_view  // NOLINT(cppcoreguidelines-special-member-functions)
    * @return 返回首次匹配的位置, 如果找不到则返回 npos
    * @note 直接包装 string_view 版本的 find_first_of
    */
-  size_type find_first_of(const char *s, size_type pos, size_type n) const noexcept
+  size_type find_first_of(const CharT *s, size_type pos, size_type n) const noexcept
   {
-    return find_first_of(string_view(s, n), pos);
+    return find_first_of(basic_string_view(s, n), pos);
   }
 
   /**
@@ -368,9 +563,9 @@ class string_view  // NOLINT(cppcoreguidelines-special-member-functions)
    * @return 返回首次匹配的位置, 如果找不到则返回 npos
    * @note 直接包装 string_view 版本的 find_first_of
    */
-  size_type find_first_of(const char *s, size_type pos = 0) const noexcept
+  size_type find_first_of(const CharT *s, size_type pos = 0) const noexcept
   {
-    return find_first_of(string_view(s), pos);
+    return find_first_of(basic_string_view(s), pos);
   }
 
   /**
@@ -378,16 +573,17 @@ class string_view  // NOLINT(cppcoreguidelines-special-member-functions)
    * @param c 要排除的字符
    * @param pos 起始位置(默认 0)
    * @return 返回首次不匹配的位置, 如果找不到则返回 npos
-   * @note 等价于 find_first_not_of(string_view(&c, 1), pos)
+   * @note 等价于 find_first_not_of(basic_string_view(&c, 1), pos)
    */
   size_type find_first_not_of(value_type c, size_type pos = 0) const noexcept
   {
-    if (pos >= size_) return npos;
+    ABIN_SV_STATS_SCOPE(find_first_not_of);
+    if (pos >= size_) return ABIN_SV_STATS_SEARCH(npos, 0);
     for (size_type i = pos; i < size_; ++i)
     {
-      if (data_[i] != c) return i;
+      if (!traits_type::eq(data_[i], c)) return ABIN_SV_STATS_SEARCH(i, i - pos + 1);
     }
-    return npos;
+    return ABIN_SV_STATS_SEARCH(npos, size_ - pos);
   }
 
   /**
@@ -398,16 +594,17 @@ class string_view  // NOLINT(cppcoreguidelines-special-member-functions)
    * @note 如果 pos >= size(), 直接返回 npos
    * @note 如果 sv 为空, 则返回 pos(只要 pos < size())
    */
-  size_type find_first_not_of(string_view sv, size_type pos = 0) const noexcept
+  size_type find_first_not_of(basic_string_view sv, size_type pos = 0) const noexcept
   {
-    if (pos >= size_) return npos;
-    if (sv.size() == 0) return pos;
+    ABIN_SV_STATS_SCOPE(find_first_not_of);
+    if (pos >= size_) return ABIN_SV_STATS_SEARCH(npos, 0);
+    if (sv.size() == 0) return ABIN_SV_STATS_SEARCH(pos, 0);
 
     for (size_type i = pos; i < size_; ++i)
     {
-      if (sv.find(data_[i]) == npos) return i;
+      if (!sv.contains_char(data_[i])) return ABIN_SV_STATS_SEARCH(i, i - pos + 1);
     }
-    return npos;
+    return ABIN_SV_STATS_SEARCH(npos, size_ - pos);
   }
 
   /**
@@ -417,9 +614,9 @@ class string_view  // NOLINT(cppcoreguidelines-special-member-functions)
    * @param n 字符数组长度
    * @return 返回首次不匹配的位置, 如果找不到则返回 npos
    */
-  size_type find_first_not_of(const char *s, size_type pos, size_type n) const noexcept
+  size_type find_first_not_of(const CharT *s, size_type pos, size_type n) const noexcept
   {
-    return find_first_not_of(string_view(s, n), pos);
+    return find_first_not_of(basic_string_view(s, n), pos);
   }
 
   /**
@@ -428,9 +625,9 @@ class string_view  // NOLINT(cppcoreguidelines-special-member-functions)
    * @param pos 起始位置(默认 0)
    * @return 返回首次不匹配的位置, 如果找不到则返回 npos
    */
-  size_type find_first_not_of(const char *s, size_type pos = 0) const noexcept
+  size_type find_first_not_of(const CharT *s, size_type pos = 0) const noexcept
   {
-    return find_first_not_of(string_view(s), pos);
+    return find_first_not_of(basic_string_view(s), pos);
   }
 
   /**
@@ -448,7 +645,7 @@ class string_view  // NOLINT(cppcoreguidelines-special-member-functions)
    * @param sv 要查找的子串
    * @return 如果包含返回 true, 否则返回 false
    */
-  bool contains(string_view sv) const noexcept
+  bool contains(basic_string_view sv) const noexcept
   {
     return find(sv) != npos;
   }
@@ -458,9 +655,9 @@ class string_view  // NOLINT(cppcoreguidelines-special-member-functions)
    * @param s 要查找的 C 字符串
    * @return 如果包含返回 true, 否则返回 false
    */
-  bool contains(const char *s) const noexcept
+  bool contains(const CharT *s) const noexcept
   {
-    return find(string_view(s)) != npos;
+    return find(basic_string_view(s)) != npos;
   }
 
   /**
@@ -471,7 +668,7 @@ class string_view  // NOLINT(cppcoreguidelines-special-member-functions)
    */
   bool starts_with(value_type c) const noexcept
   {
-    return !empty() && data_[0] == c;
+    return !empty() && traits_type::eq(data_[0], c);
   }
 
   /**
@@ -480,10 +677,12 @@ class string_view  // NOLINT(cppcoreguidelines-special-member-functions)
    * @return 如果以 sv 开头返回 true, 否则返回 false
    * @note 如果 sv.size() > size(), 直接返回 false
    */
-  bool starts_with(string_view sv) const noexcept
+  bool starts_with(basic_string_view sv) const noexcept
   {
-    if (sv.size() > size_) return false;                          // 子串比主串长 → 不可能匹配
-    return traits_type::compare(data_, sv.data_, sv.size_) == 0;  // 前 sv.size_ 个字符完全相等
+    ABIN_SV_STATS_SCOPE(starts_with);
+    if (sv.size() > size_) return ABIN_SV_STATS_PREDICATE(false, 0);  // 子串比主串长 → 不可能匹配
+    // 前 sv.size_ 个字符完全相等
+    return ABIN_SV_STATS_PREDICATE(algorithms::compare(data_, sv.data_, sv.size_) == 0, sv.size_);
   }
 
   /**
@@ -491,9 +690,9 @@ class string_view  // NOLINT(cppcoreguidelines-special-member-functions)
    * @param s C 字符串
    * @return 如果以 s 开头返回 true, 否则返回 false
    */
-  bool starts_with(const char *s) const
+  bool starts_with(const CharT *s) const
   {
-    return starts_with(string_view(s));
+    return starts_with(basic_string_view(s));
   }
 
   /**
@@ -504,7 +703,7 @@ class string_view  // NOLINT(cppcoreguidelines-special-member-functions)
    */
   bool ends_with(value_type c) const noexcept
   {
-    return !empty() && data_[size_ - 1] == c;
+    return !empty() && traits_type::eq(data_[size_ - 1], c);
   }
 
   /**
@@ -513,10 +712,12 @@ class string_view  // NOLINT(cppcoreguidelines-special-member-functions)
    * @return 如果以 sv 结尾返回 true, 否则返回 false
    * @note 如果 sv.size() > size(), 直接返回 false
    */
-  bool ends_with(string_view sv) const noexcept
+  bool ends_with(basic_string_view sv) const noexcept
   {
-    if (sv.size() > size_) return false;
-    return traits_type::compare(data_ + (size_ - sv.size_), sv.data_, sv.size_) == 0;
+    ABIN_SV_STATS_SCOPE(ends_with);
+    if (sv.size() > size_) return ABIN_SV_STATS_PREDICATE(false, 0);
+    const bool r = algorithms::compare(data_ + (size_ - sv.size_), sv.data_, sv.size_) == 0;
+    return ABIN_SV_STATS_PREDICATE(r, sv.size_);
   }
 
   /**
@@ -524,9 +725,9 @@ class string_view  // NOLINT(cppcoreguidelines-special-member-functions)
    * @param s C 字符串
    * @return 如果以 s 结尾返回 true, 否则返回 false
    */
-  bool ends_with(const char *s) const
+  bool ends_with(const CharT *s) const
   {
-    return ends_with(string_view(s));
+    return ends_with(basic_string_view(s));
   }
 
   // ---------- Modifiers ----------
@@ -543,15 +744,15 @@ class string_view  // NOLINT(cppcoreguidelines-special-member-functions)
     size_ -= n;
   }
 
-  void swap(string_view &other) noexcept
+  void swap(basic_string_view &other) noexcept
   {
     using std::swap;
     swap(data_, other.data_);
     swap(size_, other.size_);
   }
 
-  // ---------- 转 std::string ----------
-  std::string to_string() const
+  // ---------- 转 std::basic_string ----------
+  std::basic_string<CharT, Traits> to_string() const
   {
     return {data_, size_};
   }
@@ -589,51 +790,144 @@ class string_view  // NOLINT(cppcoreguidelines-special-member-functions)
   {
     return const_reverse_iterator(begin());
   }
+
+ private:
+  // 字符集合成员判断(不计入统计, 避免 find_first_of 等操作被重复统计为 find_char)
+  bool contains_char(value_type c) const noexcept
+  {
+    return size_ != 0 && traits_type::find(data_, size_, c) != nullptr;
+  }
 };
 
-inline bool operator==(string_view lhs, string_view rhs) noexcept
+// 每个运算符提供三个重载, 后两个使一侧可以隐式转换(C 字符串、std::basic_string)
+template <typename CharT, typename Traits>
+inline bool operator==(basic_string_view<CharT, Traits> lhs, basic_string_view<CharT, Traits> rhs) noexcept
+{
+  return lhs.compare(rhs) == 0;
+}
+template <typename CharT, typename Traits>
+inline bool operator==(basic_string_view<CharT, Traits> lhs,
+                  typename detail::identity<basic_string_view<CharT, Traits>>::type rhs) noexcept
 {
   return lhs.compare(rhs) == 0;
 }
-inline bool operator!=(string_view lhs, string_view rhs) noexcept
+template <typename CharT, typename Traits>
+inline bool operator==(typename detail::identity<basic_string_view<CharT, Traits>>::type lhs,
+                  basic_string_view<CharT, Traits> rhs) noexcept
 {
-  return !(lhs == rhs);
+  return lhs.compare(rhs) == 0;
 }
-inline bool operator<(string_view lhs, string_view rhs) noexcept
+template <typename CharT, typename Traits>
+inline bool operator!=(basic_string_view<CharT, Traits> lhs, basic_string_view<CharT, Traits> rhs) noexcept
+{
+  return lhs.compare(rhs) != 0;
+}
+template <typename CharT, typename Traits>
+inline bool operator!=(basic_string_view<CharT, Traits> lhs,
+                  typename detail::identity<basic_string_view<CharT, Traits>>::type rhs) noexcept
+{
+  return lhs.compare(rhs) != 0;
+}
+template <typename CharT, typename Traits>
+inline bool operator!=(typename detail::identity<basic_string_view<CharT, Traits>>::type lhs,
+                  basic_string_view<CharT, Traits> rhs) noexcept
+{
+  return lhs.compare(rhs) != 0;
+}
+template <typename CharT, typename Traits>
+inline bool operator<(basic_string_view<CharT, Traits> lhs, basic_string_view<CharT, Traits> rhs) noexcept
 {
   return lhs.compare(rhs) < 0;
 }
-inline bool operator<=(string_view lhs, string_view rhs) noexcept
+template <typename CharT, typename Traits>
+inline bool operator<(basic_string_view<CharT, Traits> lhs,
+                 typename detail::identity<basic_string_view<CharT, Traits>>::type rhs) noexcept
+{
+  return lhs.compare(rhs) < 0;
+}
+template <typename CharT, typename Traits>
+inline bool operator<(typename detail::identity<basic_string_view<CharT, Traits>>::type lhs,
+                 basic_string_view<CharT, Traits> rhs) noexcept
+{
+  return lhs.compare(rhs) < 0;
+}
+template <typename CharT, typename Traits>
+inline bool operator<=(basic_string_view<CharT, Traits> lhs, basic_string_view<CharT, Traits> rhs) noexcept
+{
+  return lhs.compare(rhs) <= 0;
+}
+template <typename CharT, typename Traits>
+inline bool operator<=(basic_string_view<CharT, Traits> lhs,
+                  typename detail::identity<basic_string_view<CharT, Traits>>::type rhs) noexcept
+{
+  return lhs.compare(rhs) <= 0;
+}
+template <typename CharT, typename Traits>
+inline bool operator<=(typename detail::identity<basic_string_view<CharT, Traits>>::type lhs,
+                  basic_string_view<CharT, Traits> rhs) noexcept
 {
   return lhs.compare(rhs) <= 0;
 }
-inline bool operator>(string_view lhs, string_view rhs) noexcept
+template <typename CharT, typename Traits>
+inline bool operator>(basic_string_view<CharT, Traits> lhs, basic_string_view<CharT, Traits> rhs) noexcept
 {
   return lhs.compare(rhs) > 0;
 }
-inline bool operator>=(string_view lhs, string_view rhs) noexcept
+template <typename CharT, typename Traits>
+inline bool operator>(basic_string_view<CharT, Traits> lhs,
+                 typename detail::identity<basic_string_view<CharT, Traits>>::type rhs) noexcept
+{
+  return lhs.compare(rhs) > 0;
+}
+template <typename CharT, typename Traits>
+inline bool operator>(typename detail::identity<basic_string_view<CharT, Traits>>::type lhs,
+                 basic_string_view<CharT, Traits> rhs) noexcept
+{
+  return lhs.compare(rhs) > 0;
+}
+template <typename CharT, typename Traits>
+inline bool operator>=(basic_string_view<CharT, Traits> lhs, basic_string_view<CharT, Traits> rhs) noexcept
+{
+  return lhs.compare(rhs) >= 0;
+}
+template <typename CharT, typename Traits>
+inline bool operator>=(basic_string_view<CharT, Traits> lhs,
+                  typename detail::identity<basic_string_view<CharT, Traits>>::type rhs) noexcept
+{
+  return lhs.compare(rhs) >= 0;
+}
+template <typename CharT, typename Traits>
+inline bool operator>=(typename detail::identity<basic_string_view<CharT, Traits>>::type lhs,
+                  basic_string_view<CharT, Traits> rhs) noexcept
 {
   return lhs.compare(rhs) >= 0;
 }
 
 // ---------- 流输出 ----------
-inline std::ostream &operator<<(std::ostream &os, string_view sv)
+template <typename CharT, typename Traits>
+inline std::basic_ostream<CharT, Traits> &operator<<(std::basic_ostream<CharT, Traits> &os,
+                                                     basic_string_view<CharT, Traits> sv)
 {
   if (sv.size() != 0) os.write(sv.data(), static_cast<std::streamsize>(sv.size()));
   return os;
 }
 
+using string_view = basic_string_view<char>;
+using wstring_view = basic_string_view<wchar_t>;
+using u16string_view = basic_string_view<char16_t>;
+using u32string_view = basic_string_view<char32_t>;
+
 }  // namespace abin
 
 // ---------- std 命名空间特化 ----------
 namespace std
 {
-template <>
-struct hash<abin::string_view> {
-  size_t operator()(const abin::string_view &sv) const noexcept
+template <typename CharT, typename Traits>
+struct hash<abin::basic_string_view<CharT, Traits>> {
+  size_t operator()(const abin::basic_string_view<CharT, Traits> &sv) const noexcept
   {
-    size_t h = 0;
-    // 使用 unsigned char 而不是 char 的原因:
+    ABIN_SV_STATS_SCOPE(hash);
+    // 代码单元先转换为对应的无符号类型再参与运算, 原因:
     // 1. 在 C++ 中, char 的 signedness 是实现定义的,
     //    可能是 signed char 或 unsigned char.
     //    如果 char 为 signed, 负值在转换为 size_t 时会生成大整数,
@@ -641,11 +935,9 @@ struct hash<abin::string_view> {
     // 2. 使用 unsigned char 可以保证每个字符在 0~255 之间,
     //    无论平台如何, hash 值都一致.
     // 3. 这样也可以安全处理任意字节序列, 包括非 ASCII 或二进制数据.
-    for (unsigned char c : sv)
-    {
-      h = (h * 131) + static_cast<size_t>(c);
-    }
-    return h;
+    // 对 char 而言结果与逐字节计算 h = h * 131 + c 完全相同.
+    const size_t h = abin::detail::polynomial_hash(sv.data(), sv.size());
+    return ABIN_SV_STATS_SCAN(h, sv.size());
   }
 };
 }  // namespace std
@@ -0,0 +1,511 @@
+/**************************************************************************************************************
+ *~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ * @file: text_index.h
+ * @description: 基于后缀数组的全文索引, 对同一个大文本反复执行子串查询.
+ * - 构建: SA-IS 算法(Nong, Zhang & Chan 2009), 时间 O(n); LCP 数组用 Φ 数组法(Kärkkäinen 2009)计算,
+ *   可按文本位置分块多线程并行(每块从 0 开始重新累计, 结果与串行相同). SA-IS 本身是串行的.
+ * - 查询: 在后缀数组上二分查找模式, 每步比较至多 m 字节:
+ *   - count / equal_range : O(m log n);
+ *   - find                : O(m log n), 匹配区间内的最小位置由区间最小值结构给出: 后缀数组每 rmq_block 个
+ *                           元素取一个块最小值, 在块最小值上建稀疏表(额外约 n / rmq_block * log n 个 int32),
+ *                           查询时扫描区间两端不足一块的部分, 中间的完整块 O(1) 查表;
+ *   - find_all            : O(m log n + occ log occ), 结果按位置升序.
+ * - 索引只引用文本, 文本在索引使用期间必须保持有效; 下标为 32 位, 文本长度不能超过 2^31 - 2.
+ * - save / load 把后缀数组与 LCP 数组写入文件, 下次直接加载; 文件记录文本长度、文本 hash 以及两个数组的 hash,
+ *   加载时校验, 与文本不符或数组被改动时失败. 文件使用本机字节序.
+ *~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ **************************************************************************************************************/
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "abin/string_view.h"
+
+namespace abin
+{
+
+namespace detail
+{
+
+/**
+ * @brief SA-IS 后缀数组构建
+ * @param s 输入序列, 取值范围 [0, upper]
+ * @param n 序列长度
+ * @param upper 最大取值
+ * @return 后缀数组
+ */
+template <typename T>
+std::vector<int32_t> sa_is(const T *s, int32_t n, int32_t upper)
+{
+  if (n == 0) return {};
+  if (n == 1) return {0};
+  if (n == 2) return s[0] < s[1] ? std::vector<int32_t>{0, 1} : std::vector<int32_t>{1, 0};
+
+  std::vector<int32_t> sa(static_cast<size_t>(n));
+  std::vector<bool> ls(static_cast<size_t>(n));  // true: S 型后缀
+  for (int32_t i = n - 2; i >= 0; --i) ls[i] = (s[i] == s[i + 1]) ? ls[i + 1] : (s[i] < s[i + 1]);
+
+  // 每个字符桶中 L 型与 S 型后缀的起点
+  std::vector<int32_t> sum_l(static_cast<size_t>(upper) + 1), sum_s(static_cast<size_t>(upper) + 1);
+  for (int32_t i = 0; i < n; ++i)
+  {
+    if (!ls[i])
+      ++sum_s[s[i]];
+    else
+      ++sum_l[s[i] + 1];
+  }
+  for (int32_t i = 0; i <= upper; ++i)
+  {
+    sum_s[i] += sum_l[i];
+    if (i < upper) sum_l[i + 1] += sum_s[i];
+  }
+
+  // 由已排序的 LMS 后缀诱导排序全部后缀
+  std::vector<int32_t> buf(static_cast<size_t>(upper) + 1);
+  auto induce = [&](const std::vector<int32_t> &lms) {
+    std::fill(sa.begin(), sa.end(), -1);
+    std::copy(sum_s.begin(), sum_s.end(), buf.begin());
+    for (int32_t d : lms)
+    {
+      if (d != n) sa[buf[s[d]]++] = d;
+    }
+    std::copy(sum_l.begin(), sum_l.end(), buf.begin());
+    sa[buf[s[n - 1]]++] = n - 1;
+    for (int32_t i = 0; i < n; ++i)
+    {
+      const int32_t v = sa[i];
+      if (v >= 1 && !ls[v - 1]) sa[buf[s[v - 1]]++] = v - 1;
+    }
+    std::copy(sum_l.begin(), sum_l.end(), buf.begin());
+    for (int32_t i = n - 1; i >= 0; --i)
+    {
+      const int32_t v = sa[i];
+      if (v >= 1 && ls[v - 1]) sa[--buf[s[v - 1] + 1]] = v - 1;
+    }
+  };
+
+  std::vector<int32_t> lms_map(static_cast<size_t>(n) + 1, -1);
+  std::vector<int32_t> lms;
+  for (int32_t i = 1; i < n; ++i)
+  {
+    if (!ls[i - 1] && ls[i])
+    {
+      lms_map[i] = static_cast<int32_t>(lms.size());
+      lms.push_back(i);
+    }
+  }
+  const int32_t m = static_cast<int32_t>(lms.size());
+  induce(lms);
+
+  if (m != 0)
+  {
+    // 给 LMS 子串编号, 相同的子串编号相同; 编号不唯一时递归排序
+    std::vector<int32_t> sorted_lms;
+    sorted_lms.reserve(lms.size());
+    for (int32_t v : sa)
+    {
+      if (lms_map[v] != -1) sorted_lms.push_back(v);
+    }
+    std::vector<int32_t> rec_s(lms.size());
+    int32_t rec_upper = 0;
+    rec_s[lms_map[sorted_lms[0]]] = 0;
+    for (int32_t i = 1; i < m; ++i)
+    {
+      int32_t l = sorted_lms[i - 1], r = sorted_lms[i];
+      const int32_t end_l = (lms_map[l] + 1 < m) ? lms[lms_map[l] + 1] : n;
+      const int32_t end_r = (lms_map[r] + 1 < m) ? lms[lms_map[r] + 1] : n;
+      bool same = true;
+      if (end_l - l != end_r - r)
+      {
+        same = false;
+      }
+      else
+      {
+        while (l < end_l && s[l] == s[r])
+        {
+          ++l;
+          ++r;
+        }
+        if (l == n || s[l] != s[r]) same = false;
+      }
+      if (!same) ++rec_upper;
+      rec_s[lms_map[sorted_lms[i]]] = rec_upper;
+    }
+    const std::vector<int32_t> rec_sa = sa_is(rec_s.data(), m, rec_upper);
+    for (int32_t i = 0; i < m; ++i) sorted_lms[i] = lms[rec_sa[i]];
+    induce(sorted_lms);
+  }
+  return sa;
+}
+
+/**
+ * @brief Φ 数组法计算 LCP: 先按文本顺序求 PLCP, 再按后缀数组顺序重排
+ * @param text 文本
+ * @param sa 后缀数组
+ * @param threads 线程数; 文本按位置分块, 每块独立累计
+ * @return lcp[r] = 后缀 sa[r - 1] 与 sa[r] 的最长公共前缀长度, lcp[0] = 0
+ */
+inline std::vector<int32_t> build_lcp(string_view text, const std::vector<int32_t> &sa, unsigned threads)
+{
+  const size_t n = sa.size();
+  std::vector<int32_t> plcp(n, -1);  // 先存 Φ, 再原地改为 PLCP
+  for (size_t r = 1; r < n; ++r) plcp[sa[r]] = sa[r - 1];
+
+  auto fill = [&text, &plcp, n](size_t begin, size_t end) {
+    size_t l = 0;
+    for (size_t i = begin; i < end; ++i)
+    {
+      const int32_t prev = plcp[i];
+      if (prev < 0)
+      {
+        plcp[i] = 0;
+        l = 0;
+        continue;
+      }
+      const size_t j = static_cast<size_t>(prev);
+      while (i + l < n && j + l < n && text[i + l] == text[j + l]) ++l;
+      plcp[i] = static_cast<int32_t>(l);
+      if (l > 0) --l;  // PLCP[i + 1] >= PLCP[i] - 1
+    }
+  };
+
+  const size_t blocks = std::max<size_t>(1, std::min<size_t>(threads, n / 65536 + 1));
+  if (blocks == 1)
+  {
+    fill(0, n);
+  }
+  else
+  {
+    std::vector<std::thread> workers;
+    const size_t step = (n + blocks - 1) / blocks;
+    for (size_t b = 0; b < blocks; ++b) workers.emplace_back(fill, b * step, std::min(n, (b + 1) * step));
+    for (std::thread &t : workers) t.join();
+  }
+
+  std::vector<int32_t> lcp(n);
+  for (size_t r = 0; r < n; ++r) lcp[r] = plcp[sa[r]];
+  return lcp;
+}
+
+}  // namespace detail
+
+// ---------- text_index 类 ----------
+class text_index
+{
+ public:
+  enum : size_t { npos = static_cast<size_t>(-1) };
+  // 可索引的最大文本长度
+  enum : size_t { max_text_size = 0x7FFFFFFE };
+  // find 使用的区间最小值结构的块长度
+  enum : size_t { rmq_block = 128 };
+
+  text_index() = default;
+
+  /**
+   * @brief 为 text 构建索引
+   * @param text 文本, 索引使用期间必须保持有效
+   * @param threads LCP 计算使用的线程数, 0 表示使用硬件并发数
+   * @note 文本超过 max_text_size 时抛出 std::length_error
+   */
+  explicit text_index(string_view text, unsigned threads = 1) : text_(text)
+  {
+    if (text.size() > max_text_size) throw std::length_error("abin::text_index: text too large");
+    if (threads == 0) threads = std::max(1U, std::thread::hardware_concurrency());
+    const auto *s = reinterpret_cast<const unsigned char *>(text.data());
+    sa_ = detail::sa_is(s, static_cast<int32_t>(text.size()), 255);
+    lcp_ = detail::build_lcp(text, sa_, threads);
+    build_block_min();
+  }
+
+  string_view text() const noexcept
+  {
+    return text_;
+  }
+
+  size_t size() const noexcept
+  {
+    return text_.size();
+  }
+
+  bool empty() const noexcept
+  {
+    return text_.empty();
+  }
+
+  // 后缀数组: 所有后缀起点按后缀字典序排列
+  const std::vector<int32_t> &suffix_array() const noexcept
+  {
+    return sa_;
+  }
+
+  // lcp()[r]: 相邻后缀 sa[r - 1] 与 sa[r] 的最长公共前缀长度, lcp()[0] 为 0
+  const std::vector<int32_t> &lcp() const noexcept
+  {
+    return lcp_;
+  }
+
+  /**
+   * @brief 以 pattern 为前缀的后缀在后缀数组中的区间
+   * @param pattern 模式
+   * @return [first, second) 下标区间, 不存在时为空区间
+   */
+  std::pair<size_t, size_t> equal_range(string_view pattern) const noexcept
+  {
+    size_t lo = 0, hi = sa_.size();
+    while (lo < hi)  // 第一个 >= pattern 的后缀
+    {
+      const size_t mid = lo + (hi - lo) / 2;
+      if (compare_at(mid, pattern) < 0)
+        lo = mid + 1;
+      else
+        hi = mid;
+    }
+    const size_t first = lo;
+    hi = sa_.size();
+    while (lo < hi)  // 第一个前缀 > pattern 的后缀
+    {
+      const size_t mid = lo + (hi - lo) / 2;
+      if (compare_at(mid, pattern) <= 0)
+        lo = mid + 1;
+      else
+        hi = mid;
+    }
+    return {first, lo};
+  }
+
+  /**
+   * @brief 统计 pattern 的出现次数(可重叠)
+   * @note 空模式与 string_view::find 一致, 视为在 size() + 1 个位置出现
+   */
+  size_t count(string_view pattern) const noexcept
+  {
+    if (pattern.empty()) return text_.size() + 1;
+    const std::pair<size_t, size_t> r = equal_range(pattern);
+    return r.second - r.first;
+  }
+
+  bool contains(string_view pattern) const noexcept
+  {
+    return pattern.empty() || count(pattern) != 0;
+  }
+
+  /**
+   * @brief 查找 pattern 第一次出现的位置
+   * @return 最小的出现位置, 与 text().find(pattern) 相同; 找不到返回 npos
+   */
+  size_t find(string_view pattern) const noexcept
+  {
+    if (pattern.empty()) return 0;
+    const std::pair<size_t, size_t> r = equal_range(pattern);
+    if (r.first == r.second) return npos;
+    return static_cast<size_t>(range_min(r.first, r.second));
+  }
+
+  // pattern 的所有出现位置(可重叠), 按升序排列
+  std::vector<size_t> find_all(string_view pattern) const
+  {
+    std::vector<size_t> out;
+    if (pattern.empty())
+    {
+      out.reserve(text_.size() + 1);
+      for (size_t i = 0; i <= text_.size(); ++i) out.push_back(i);
+      return out;
+    }
+    const std::pair<size_t, size_t> r = equal_range(pattern);
+    out.reserve(r.second - r.first);
+    for (size_t k = r.first; k < r.second; ++k) out.push_back(static_cast<size_t>(sa_[k]));
+    std::sort(out.begin(), out.end());
+    return out;
+  }
+
+  // 最长的重复子串(至少出现两次, 可重叠), 没有时返回空视图
+  string_view longest_repeat() const noexcept
+  {
+    size_t best = 0;
+    for (size_t r = 1; r < lcp_.size(); ++r)
+    {
+      if (lcp_[r] > lcp_[best]) best = r;
+    }
+    if (lcp_.empty() || lcp_[best] == 0) return string_view();
+    return text_.substr(static_cast<size_t>(sa_[best]), static_cast<size_t>(lcp_[best]));
+  }
+
+  /**
+   * @brief 把索引写入文件
+   * @param path 文件路径
+   * @return 成功返回 true
+   */
+  bool save(const std::string &path) const
+  {
+    std::FILE *f = std::fopen(path.c_str(), "wb");
+    if (f == nullptr) return false;
+    const file_header h = make_header(text_, sa_, lcp_);
+    bool ok = std::fwrite(&h, sizeof(h), 1, f) == 1;
+    ok = ok && write_array(f, sa_) && write_array(f, lcp_);
+    ok = (std::fclose(f) == 0) && ok;
+    return ok;
+  }
+
+  /**
+   * @brief 从文件加载为 text 构建的索引
+   * @param path 文件路径
+   * @param text 构建索引时使用的文本(内容必须相同)
+   * @return 成功返回 true; 文件损坏或与 text 不符时返回 false, 当前索引不变
+   * @note 数组内容由文件头中的 hash 校验(非密码学 hash, 只用于发现意外损坏);
+   *       另外逐项检查数组, 保证即使 hash 碰撞, 之后的查询也不会越界
+   */
+  bool load(const std::string &path, string_view text)
+  {
+    std::FILE *f = std::fopen(path.c_str(), "rb");
+    if (f == nullptr) return false;
+    file_header h;
+    std::vector<int32_t> sa, lcp;
+    bool ok = std::fread(&h, sizeof(h), 1, f) == 1;
+    ok = ok && read_array(f, sa, text.size()) && read_array(f, lcp, text.size()) && std::fgetc(f) == EOF;
+    std::fclose(f);
+    if (!ok) return false;
+    const file_header expected = make_header(text, sa, lcp);
+    if (std::memcmp(&h, &expected, sizeof(h)) != 0 || !valid_arrays(text, sa, lcp)) return false;
+    text_ = text;
+    sa_.swap(sa);
+    lcp_.swap(lcp);
+    build_block_min();
+    return true;
+  }
+
+ private:
+  struct file_header {
+    char magic[8];
+    uint32_t version;
+    uint32_t index_bytes;
+    uint64_t text_size;
+    uint64_t text_hash;
+    uint64_t sa_hash;
+    uint64_t lcp_hash;
+  };
+
+  enum : uint32_t { format_version = 2 };
+
+  static uint64_t array_hash(const std::vector<int32_t> &a) noexcept
+  {
+    return detail::polynomial_hash(reinterpret_cast<const char *>(a.data()), a.size() * sizeof(int32_t));
+  }
+
+  static file_header make_header(string_view text, const std::vector<int32_t> &sa,
+                                 const std::vector<int32_t> &lcp) noexcept
+  {
+    file_header h;
+    std::memcpy(h.magic, "ABINSAIX", sizeof(h.magic));
+    h.version = format_version;
+    h.index_bytes = sizeof(int32_t);
+    h.text_size = text.size();
+    h.text_hash = detail::polynomial_hash(text.data(), text.size());
+    h.sa_hash = array_hash(sa);
+    h.lcp_hash = array_hash(lcp);
+    return h;
+  }
+
+  static bool write_array(std::FILE *f, const std::vector<int32_t> &a)
+  {
+    return a.empty() || std::fwrite(a.data(), sizeof(int32_t), a.size(), f) == a.size();
+  }
+
+  static bool read_array(std::FILE *f, std::vector<int32_t> &a, size_t n)
+  {
+    a.resize(n);
+    return n == 0 || std::fread(a.data(), sizeof(int32_t), n, f) == n;
+  }
+
+  /**
+   * @brief 检查从文件读入的数组, 确保查询不会越界
+   * @note O(n): sa 必须是 [0, n) 的排列; lcp[0] == 0, lcp[r] 不超过两个相邻后缀的长度,
+   *       且两个后缀在第 lcp[r] 个字符处按字典序递增(或前者恰好结束)
+   */
+  static bool valid_arrays(string_view text, const std::vector<int32_t> &sa, const std::vector<int32_t> &lcp)
+  {
+    const size_t n = text.size();
+    std::vector<bool> seen(n, false);
+    for (int32_t v : sa)
+    {
+      if (v < 0 || static_cast<size_t>(v) >= n || seen[static_cast<size_t>(v)]) return false;
+      seen[static_cast<size_t>(v)] = true;
+    }
+    if (n != 0 && lcp[0] != 0) return false;
+    for (size_t r = 1; r < n; ++r)
+    {
+      if (lcp[r] < 0) return false;
+      const auto l = static_cast<size_t>(lcp[r]);
+      const auto a = static_cast<size_t>(sa[r - 1]);
+      const auto b = static_cast<size_t>(sa[r]);
+      if (l > n - a || l > n - b) return false;
+      if (a + l == n) continue;  // 前一个后缀是后一个的前缀
+      if (b + l == n) return false;
+      if (static_cast<unsigned char>(text[a + l]) >= static_cast<unsigned char>(text[b + l])) return false;
+    }
+    return true;
+  }
+
+  // 建立 find 使用的区间最小值结构: block_min_[k][b] 为从第 b 块开始的 2^k 个完整块中 sa 的最小值
+  void build_block_min()
+  {
+    block_min_.clear();
+    const size_t blocks = sa_.size() / rmq_block;
+    if (blocks == 0) return;
+    std::vector<int32_t> level(blocks);
+    for (size_t b = 0; b < blocks; ++b)
+    {
+      const auto first = sa_.begin() + static_cast<ptrdiff_t>(b * rmq_block);
+      level[b] = *std::min_element(first, first + static_cast<ptrdiff_t>(rmq_block));
+    }
+    block_min_.push_back(std::move(level));
+    for (size_t half = 1; 2 * half <= blocks; half *= 2)
+    {
+      const std::vector<int32_t> &prev = block_min_.back();
+      std::vector<int32_t> next(blocks - 2 * half + 1);
+      for (size_t b = 0; b < next.size(); ++b) next[b] = std::min(prev[b], prev[b + half]);
+      block_min_.push_back(std::move(next));
+    }
+  }
+
+  // sa_[first, last) 中的最小值(first < last)
+  int32_t range_min(size_t first, size_t last) const noexcept
+  {
+    const size_t bl = (first + rmq_block - 1) / rmq_block;  // 区间内第一个完整块
+    const size_t br = last / rmq_block;                     // 区间内完整块的结尾
+    if (bl >= br)
+    {
+      return *std::min_element(sa_.begin() + static_cast<ptrdiff_t>(first), sa_.begin() + static_cast<ptrdiff_t>(last));
+    }
+    size_t k = 0;
+    while ((size_t{2} << k) <= br - bl) ++k;
+    int32_t best = std::min(block_min_[k][bl], block_min_[k][br - (size_t{1} << k)]);
+    for (size_t r = first; r < bl * rmq_block; ++r) best = std::min(best, sa_[r]);
+    for (size_t r = br * rmq_block; r < last; ++r) best = std::min(best, sa_[r]);
+    return best;
+  }
+
+  // 后缀 sa_[r] 的前 |pattern| 个字符与 pattern 比较
+  int compare_at(size_t r, string_view pattern) const noexcept
+  {
+    const auto pos = static_cast<size_t>(sa_[r]);
+    const size_t len = std::min(pattern.size(), text_.size() - pos);
+    return string_view(text_.data() + pos, len).compare(pattern);
+  }
+
+  string_view text_;
+  std::vector<int32_t> sa_;
+  std::vector<int32_t> lcp_;
+  std::vector<std::vector<int32_t>> block_min_;
+};
+
+}  // namespace abin
@@ -0,0 +1,159 @@
+/**************************************************************************************************************
+ *~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ * @file: utf8.h
+ * @description: 基于 abin::string_view 的 UTF-8 校验、码点计数与码点迭代.
+ * - is_valid_utf8  : 严格校验(拒绝过长编码、代理项、超出 U+10FFFF 的码点及截断序列).
+ *   - CPU 支持 SSSE3 时使用 Keller/Lemire 查表算法, 每次处理 16 字节(运行期选择, 见 abin/dispatch.h);
+ *   - 纯 ASCII 块走快速路径, 只做一次 movemask 判断;
+ *   - 否则退化为 8 字节 ASCII 快速路径 + 标量解码.
+ * - utf8_length    : 统计码点个数(即非续字节个数), 输入须为合法 UTF-8.
+ * - utf8_iterator  : 单遍码点迭代器, 非法字节解码为 U+FFFD 并前进 1 字节.
+ *~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ **************************************************************************************************************/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+
+#include "abin/detail/utf8_kernels.h"
+#include "abin/dispatch.h"
+#include "abin/string_view.h"
+
+namespace abin
+{
+
+/**
+ * @brief 检查 sv 是否为合法的 UTF-8 序列
+ * @param sv 待检查的字节序列
+ * @return 合法返回 true, 否则返回 false
+ * @note 拒绝过长编码、UTF-16 代理项(U+D800~U+DFFF)、大于 U+10FFFF 的码点及截断的多字节序列
+ */
+inline bool is_valid_utf8(string_view sv) noexcept
+{
+  const auto *p = reinterpret_cast<const unsigned char *>(sv.data());
+  return dispatch::kernels::validate_utf8()(p, sv.size());
+}
+
+/**
+ * @brief 统计 sv 中的码点个数
+ * @param sv UTF-8 字节序列
+ * @return 码点个数
+ * @note 实际统计的是非续字节(不是 10xxxxxx)的个数, 仅当 sv 为合法 UTF-8 时才等于码点个数
+ */
+inline size_t utf8_length(string_view sv) noexcept
+{
+  const auto *p = reinterpret_cast<const unsigned char *>(sv.data());
+#if defined(ABIN_SV_HAS_SSE2)
+  return detail::utf8_count_sse2(p, sv.size());
+#else
+  return detail::utf8_count_scalar(p, sv.size());
+#endif
+}
+
+// ---------- utf8_iterator 类 ----------
+// 在 UTF-8 字节序列上逐码点前进的只读迭代器.
+// 解引用按值返回解码后的码点(没有可供引用的 char32_t 对象), 因此声明为输入迭代器;
+// 复制迭代器并重复遍历仍然安全.
+// 非法或截断的序列解码为 U+FFFD(替换字符)并只前进 1 字节, 因此任何输入都能遍历到末尾.
+class utf8_iterator
+{
+ public:
+  using iterator_category = std::input_iterator_tag;
+  using value_type = char32_t;
+  using difference_type = ptrdiff_t;
+  using pointer = const char32_t *;
+  using reference = char32_t;
+
+  enum : char32_t { replacement_character = 0xFFFD };
+
+  utf8_iterator() noexcept : pos_(nullptr), end_(nullptr) {}
+  utf8_iterator(const char *pos, const char *end) noexcept : pos_(pos), end_(end) {}
+
+  // 当前码点; 位于末尾时行为未定义
+  char32_t operator*() const noexcept
+  {
+    char32_t cp = 0;
+    return decode(cp) != 0 ? cp : static_cast<char32_t>(replacement_character);
+  }
+
+  utf8_iterator &operator++() noexcept
+  {
+    char32_t cp = 0;
+    const size_t len = decode(cp);
+    pos_ += (len != 0) ? len : 1;
+    return *this;
+  }
+
+  utf8_iterator operator++(int) noexcept
+  {
+    utf8_iterator tmp = *this;
+    ++*this;
+    return tmp;
+  }
+
+  // 当前码点在底层字节序列中的位置
+  const char *base() const noexcept
+  {
+    return pos_;
+  }
+
+  // 当前码点占用的字节数, 非法序列返回 1
+  size_t code_unit_count() const noexcept
+  {
+    char32_t cp = 0;
+    const size_t len = decode(cp);
+    return (len != 0) ? len : 1;
+  }
+
+  friend bool operator==(const utf8_iterator &lhs, const utf8_iterator &rhs) noexcept
+  {
+    return lhs.pos_ == rhs.pos_;
+  }
+  friend bool operator!=(const utf8_iterator &lhs, const utf8_iterator &rhs) noexcept
+  {
+    return lhs.pos_ != rhs.pos_;
+  }
+
+ private:
+  size_t decode(char32_t &cp) const noexcept
+  {
+    return detail::utf8_decode(reinterpret_cast<const unsigned char *>(pos_), static_cast<size_t>(end_ - pos_), cp);
+  }
+
+  const char *pos_;
+  const char *end_;
+};
+
+// ---------- utf8_range 类 ----------
+// 可用于范围 for 循环的码点视图: for (char32_t cp : abin::utf8_code_points(sv)) { ... }
+class utf8_range
+{
+ public:
+  explicit utf8_range(string_view sv) noexcept : sv_(sv) {}
+
+  utf8_iterator begin() const noexcept
+  {
+    return {sv_.data(), sv_.data() + sv_.size()};
+  }
+  utf8_iterator end() const noexcept
+  {
+    return {sv_.data() + sv_.size(), sv_.data() + sv_.size()};
+  }
+
+ private:
+  string_view sv_;
+};
+
+/**
+ * @brief 返回 sv 的码点视图, 便于用范围 for 循环逐码点遍历
+ * @param sv UTF-8 字节序列
+ * @return utf8_range 视图(不拷贝数据)
+ */
+inline utf8_range utf8_code_points(string_view sv) noexcept
+{
+  return utf8_range(sv);
+}
+
+}  // namespace abin
@@ -0,0 +1,322 @@
+/**************************************************************************************************************
+ *~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ * @file: view_table.h
+ * @description: 相对同一个底层缓冲区的紧凑子串句柄, 用于存放海量子串.
+ * - compact_view : 32 位偏移 + 32 位长度, 共 8 字节, 是 abin::string_view(指针 + size_t, 16 字节)的一半;
+ *   句柄本身不含指针, 需要配合底层缓冲区解析为 string_view. 缓冲区不能超过 4 GiB.
+ * - view_table   : 保存底层缓冲区与句柄数组的容器, 下标访问直接返回 string_view;
+ *   同样数量的子串占用一半内存, 一条缓存行可容纳 8 个句柄.
+ * - 边界检查: 调试构建(未定义 NDEBUG)中, 创建与解析句柄时用 assert 检查句柄是否位于缓冲区内;
+ *   at() 在任何构建中都检查并抛出 std::out_of_range. 发布构建中 operator[] 不做检查.
+ *~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ **************************************************************************************************************/
+
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <stdexcept>
+#include <vector>
+
+#include "abin/string_view.h"
+
+namespace abin
+{
+
+// ---------- compact_view ----------
+struct compact_view {
+  uint32_t offset;  // 相对底层缓冲区起点的偏移
+  uint32_t length;  // 子串长度
+
+  compact_view() noexcept : offset(0), length(0) {}
+  compact_view(uint32_t off, uint32_t len) noexcept : offset(off), length(len) {}
+
+  size_t size() const noexcept
+  {
+    return length;
+  }
+
+  bool empty() const noexcept
+  {
+    return length == 0;
+  }
+
+  // 句柄是否完全位于长度为 base_size 的缓冲区内
+  bool fits(size_t base_size) const noexcept
+  {
+    return offset <= base_size && length <= base_size - offset;
+  }
+
+  /**
+   * @brief 解析为指向 base 的 string_view
+   * @param base 底层缓冲区
+   * @note 调试构建中检查句柄是否越界
+   */
+  string_view resolve(string_view base) const noexcept
+  {
+    assert(fits(base.size()) && "abin::compact_view out of range");
+    return string_view(base.data() + offset, length);
+  }
+
+  /**
+   * @brief 取子串句柄, 语义与 string_view::substr 相同
+   * @param pos 起始位置
+   * @param count 长度(默认到末尾)
+   * @return 子串句柄; pos 超过长度时抛出 std::out_of_range
+   */
+  compact_view substr(size_t pos = 0, size_t count = string_view::npos) const
+  {
+    if (pos > length) throw std::out_of_range("abin::compact_view::substr");
+    const size_t n = count < length - pos ? count : length - pos;
+    return compact_view(static_cast<uint32_t>(offset + pos), static_cast<uint32_t>(n));
+  }
+};
+
+static_assert(sizeof(compact_view) == 8, "compact_view must be 8 bytes");
+
+inline bool operator==(compact_view lhs, compact_view rhs) noexcept
+{
+  return lhs.offset == rhs.offset && lhs.length == rhs.length;
+}
+
+inline bool operator!=(compact_view lhs, compact_view rhs) noexcept
+{
+  return !(lhs == rhs);
+}
+
+// ---------- view_table 类 ----------
+class view_table
+{
+ public:
+  // 底层缓冲区的最大长度
+  enum : size_t { max_base_size = 0xFFFFFFFFU };
+
+  // 依次产出 string_view 的只读迭代器. 解引用得到临时的 string_view(按值返回),
+  // 因此 operator-> 返回一个持有该值的代理对象.
+  // 这是 C++20 意义上的代理迭代器: 提供随机访问迭代器的全部操作, 并通过 iterator_concept
+  // 满足 std::random_access_iterator; 但按值返回的 reference 不满足 C++17 及以前前向迭代器的要求,
+  // 所以 iterator_category 只声明为输入迭代器(与 std::ranges::iota_view 的迭代器相同).
+  class const_iterator
+  {
+   public:
+    struct arrow_proxy {
+      string_view value;
+      const string_view *operator->() const noexcept
+      {
+        return &value;
+      }
+    };
+
+    using iterator_category = std::input_iterator_tag;
+#if defined(__cpp_lib_ranges)
+    using iterator_concept = std::random_access_iterator_tag;
+#endif
+    using value_type = string_view;
+    using difference_type = ptrdiff_t;
+    using pointer = arrow_proxy;
+    using reference = string_view;
+
+    const_iterator() noexcept : it_(), base_() {}
+    const_iterator(std::vector<compact_view>::const_iterator it, string_view base) noexcept : it_(it), base_(base) {}
+
+    string_view operator*() const noexcept
+    {
+      return it_->resolve(base_);
+    }
+    arrow_proxy operator->() const noexcept
+    {
+      return arrow_proxy{it_->resolve(base_)};
+    }
+    string_view operator[](difference_type n) const noexcept
+    {
+      return it_[n].resolve(base_);
+    }
+    const_iterator &operator++() noexcept
+    {
+      ++it_;
+      return *this;
+    }
+    const_iterator operator++(int) noexcept
+    {
+      const_iterator t = *this;
+      ++it_;
+      return t;
+    }
+    const_iterator &operator--() noexcept
+    {
+      --it_;
+      return *this;
+    }
+    const_iterator operator--(int) noexcept
+    {
+      const_iterator t = *this;
+      --it_;
+      return t;
+    }
+    const_iterator &operator+=(difference_type n) noexcept
+    {
+      it_ += n;
+      return *this;
+    }
+    const_iterator &operator-=(difference_type n) noexcept
+    {
+      it_ -= n;
+      return *this;
+    }
+    const_iterator operator+(difference_type n) const noexcept
+    {
+      return const_iterator(it_ + n, base_);
+    }
+    const_iterator operator-(difference_type n) const noexcept
+    {
+      return const_iterator(it_ - n, base_);
+    }
+    difference_type operator-(const const_iterator &other) const noexcept
+    {
+      return it_ - other.it_;
+    }
+    bool operator==(const const_iterator &other) const noexcept
+    {
+      return it_ == other.it_;
+    }
+    bool operator!=(const const_iterator &other) const noexcept
+    {
+      return it_ != other.it_;
+    }
+    bool operator<(const const_iterator &other) const noexcept
+    {
+      return it_ < other.it_;
+    }
+    bool operator>(const const_iterator &other) const noexcept
+    {
+      return it_ > other.it_;
+    }
+    bool operator<=(const const_iterator &other) const noexcept
+    {
+      return it_ <= other.it_;
+    }
+    bool operator>=(const const_iterator &other) const noexcept
+    {
+      return it_ >= other.it_;
+    }
+    friend const_iterator operator+(difference_type n, const const_iterator &it) noexcept
+    {
+      return it + n;
+    }
+
+   private:
+    std::vector<compact_view>::const_iterator it_;
+    string_view base_;
+  };
+  using iterator = const_iterator;
+
+  view_table() = default;
+
+  /**
+   * @brief 构造空表
+   * @param base 底层缓冲区, 使用期间必须保持有效
+   * @note 缓冲区超过 max_base_size 时抛出 std::length_error
+   */
+  explicit view_table(string_view base) : base_(base)
+  {
+    if (base.size() > max_base_size) throw std::length_error("abin::view_table: base buffer too large");
+  }
+
+  string_view base() const noexcept
+  {
+    return base_;
+  }
+
+  /**
+   * @brief 为位于底层缓冲区内的子串创建句柄(不加入表中)
+   * @param sub 子串, 必须指向 base() 内部; 调试构建中检查
+   */
+  compact_view make(string_view sub) const noexcept
+  {
+    if (sub.empty()) return compact_view();
+    assert(sub.data() >= base_.data() && sub.data() + sub.size() <= base_.data() + base_.size() &&
+           "abin::view_table::make: view is outside the base buffer");
+    return compact_view(static_cast<uint32_t>(sub.data() - base_.data()), static_cast<uint32_t>(sub.size()));
+  }
+
+  // 追加一个子串, 返回其下标
+  size_t push_back(string_view sub)
+  {
+    return push_back(make(sub));
+  }
+
+  // 追加一个句柄, 返回其下标
+  size_t push_back(compact_view h)
+  {
+    assert(h.fits(base_.size()) && "abin::view_table::push_back: handle is outside the base buffer");
+    handles_.push_back(h);
+    return handles_.size() - 1;
+  }
+
+  // 解析任意句柄
+  string_view resolve(compact_view h) const noexcept
+  {
+    return h.resolve(base_);
+  }
+
+  string_view operator[](size_t i) const noexcept
+  {
+    assert(i < handles_.size() && "abin::view_table index out of range");
+    return handles_[i].resolve(base_);
+  }
+
+  // 带边界检查的访问: 下标或句柄越界时抛出 std::out_of_range
+  string_view at(size_t i) const
+  {
+    if (i >= handles_.size() || !handles_[i].fits(base_.size())) throw std::out_of_range("abin::view_table::at");
+    return handles_[i].resolve(base_);
+  }
+
+  compact_view handle(size_t i) const noexcept
+  {
+    return handles_[i];
+  }
+
+  const std::vector<compact_view> &handles() const noexcept
+  {
+    return handles_;
+  }
+
+  const_iterator begin() const noexcept
+  {
+    return const_iterator(handles_.begin(), base_);
+  }
+
+  const_iterator end() const noexcept
+  {
+    return const_iterator(handles_.end(), base_);
+  }
+
+  size_t size() const noexcept
+  {
+    return handles_.size();
+  }
+
+  bool empty() const noexcept
+  {
+    return handles_.empty();
+  }
+
+  void reserve(size_t n)
+  {
+    handles_.reserve(n);
+  }
+
+  void clear() noexcept
+  {
+    handles_.clear();
+  }
+
+ private:
+  string_view base_;
+  std::vector<compact_view> handles_;
+};
+
+}  // namespace abin
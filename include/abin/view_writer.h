@@ -0,0 +1,263 @@
+/**************************************************************************************************************
+ *~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ * @file: view_writer.h
+ * @description: 把多个 abin::string_view 片段聚合后一次性写入文件描述符(scatter-gather 输出).
+ * - 较长的片段不拷贝, 直接作为一个 iovec 引用原数据; 较短的片段拷贝到内部缓冲区,
+ *   相邻的短片段合并为同一个 iovec, 避免大量几字节的 iovec.
+ * - flush() 通过 writev 一次提交所有片段, 正确处理部分写入与 EINTR;
+ *   非阻塞描述符返回 EAGAIN 时保留未写完的部分, 下次 flush() 继续.
+ * - 片段数达到批量上限(不超过 IOV_MAX)或缓冲区写满时自动 flush.
+ * - 注意: 零拷贝片段引用调用者的内存, 在 flush() 成功之前必须保持有效.
+ * - Windows 上没有 writev, 退化为逐片段调用 _write.
+ *~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ **************************************************************************************************************/
+
+#pragma once
+
+#include <algorithm>
+#include <cerrno>
+#include <climits>
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <vector>
+
+#include "abin/string_view.h"
+
+#if defined(_WIN32)
+#include <io.h>
+#else
+#include <sys/uio.h>
+#include <unistd.h>
+#endif
+
+namespace abin
+{
+
+namespace detail
+{
+
+#if defined(_WIN32)
+struct io_slice {
+  void *iov_base;
+  size_t iov_len;
+};
+
+// 只写第一个片段, 由调用方按部分写入处理剩余部分
+inline ptrdiff_t write_slices(int fd, const io_slice *slices, size_t count) noexcept
+{
+  if (count == 0) return 0;
+  const size_t len = slices[0].iov_len < static_cast<size_t>(INT_MAX) ? slices[0].iov_len : INT_MAX;
+  return static_cast<ptrdiff_t>(::_write(fd, slices[0].iov_base, static_cast<unsigned>(len)));
+}
+#else
+using io_slice = ::iovec;
+
+inline ptrdiff_t write_slices(int fd, const io_slice *slices, size_t count) noexcept
+{
+  return static_cast<ptrdiff_t>(::writev(fd, slices, static_cast<int>(count)));
+}
+#endif
+
+// 单次 writev 可提交的最大片段数
+enum : size_t {
+#if defined(IOV_MAX)
+  max_io_slices = IOV_MAX
+#else
+  max_io_slices = 1024
+#endif
+};
+
+}  // namespace detail
+
+// ---------- view_writer 类 ----------
+class view_writer
+{
+ public:
+  enum : size_t {
+    default_batch_limit = 64,       // 默认每批最多 64 个 iovec
+    default_copy_threshold = 64,    // 短于 64 字节的片段拷贝进缓冲区
+    default_buffer_capacity = 4096  // 内部缓冲区大小
+  };
+
+  /**
+   * @brief 构造写入器
+   * @param fd 目标文件描述符(不接管所有权, 析构时不关闭)
+   * @param batch_limit 每批最多的 iovec 个数, 达到后自动 flush; 会被限制在 [1, IOV_MAX]
+   * @param copy_threshold 短于该长度的片段拷贝到内部缓冲区, 其余片段零拷贝引用
+   * @param buffer_capacity 内部缓冲区大小(字节)
+   */
+  explicit view_writer(int fd, size_t batch_limit = default_batch_limit, size_t copy_threshold = default_copy_threshold,
+                       size_t buffer_capacity = default_buffer_capacity) :
+    fd_(fd),
+    batch_limit_(std::max<size_t>(1, std::min<size_t>(batch_limit, detail::max_io_slices))),
+    copy_threshold_(std::min(copy_threshold, buffer_capacity)),
+    buffer_(new char[buffer_capacity != 0 ? buffer_capacity : 1]),
+    buffer_capacity_(buffer_capacity),
+    buffer_used_(0),
+    first_(0),
+    pending_bytes_(0),
+    error_(0)
+  {
+    slices_.reserve(batch_limit_);
+  }
+
+  view_writer(const view_writer &) = delete;
+  view_writer &operator=(const view_writer &) = delete;
+
+  // 析构时尽力写出剩余数据, 忽略错误
+  ~view_writer()
+  {
+    flush();
+  }
+
+  /**
+   * @brief 追加一个片段
+   * @param sv 片段内容; 长度不小于 copy_threshold 时只记录指针, flush() 前必须保持有效
+   * @return 自动 flush 失败时返回 false(错误码见 error()), 片段仍保留在队列中
+   */
+  bool append(string_view sv)
+  {
+    if (sv.empty()) return true;
+    bool ok = true;
+    if (sv.size() < copy_threshold_)
+    {
+      if (buffer_capacity_ - buffer_used_ < sv.size()) ok = flush();
+      if (buffer_capacity_ - buffer_used_ < sv.size())
+      {
+        // 非阻塞描述符暂时写不出去, 缓冲区仍被占用: 拷贝到单独分配的内存, 保证短片段总是被拷贝
+        spill_.emplace_back(new char[sv.size()]);
+        std::memcpy(spill_.back().get(), sv.data(), sv.size());
+        push_slice(spill_.back().get(), sv.size());
+      }
+      else
+      {
+        char *dst = buffer_.get() + buffer_used_;
+        std::memcpy(dst, sv.data(), sv.size());
+        buffer_used_ += sv.size();
+        // 与上一个缓冲区片段相邻时直接扩展该片段
+        if (slices_.size() > first_ &&
+            static_cast<char *>(slices_.back().iov_base) + slices_.back().iov_len == dst)
+        {
+          slices_.back().iov_len += sv.size();
+          pending_bytes_ += sv.size();
+        }
+        else
+        {
+          push_slice(dst, sv.size());
+        }
+      }
+    }
+    else
+    {
+      push_slice(sv.data(), sv.size());
+    }
+    if (slices_.size() - first_ >= batch_limit_) ok = flush() && ok;
+    return ok;
+  }
+
+  view_writer &operator<<(string_view sv)
+  {
+    append(sv);
+    return *this;
+  }
+
+  /**
+   * @brief 写出所有已排队的片段
+   * @return 全部写出返回 true; 出错(含非阻塞描述符的 EAGAIN)返回 false, 未写出的部分保留, 可再次调用
+   */
+  bool flush()
+  {
+    while (first_ < slices_.size())
+    {
+      const size_t count = std::min(slices_.size() - first_, batch_limit_);
+      const ptrdiff_t n = detail::write_slices(fd_, slices_.data() + first_, count);
+      if (n < 0)
+      {
+        if (errno == EINTR) continue;
+        error_ = errno;
+        return false;
+      }
+      if (n == 0)  // 没有任何进展, 避免死循环
+      {
+        error_ = EIO;
+        return false;
+      }
+      consume(static_cast<size_t>(n));
+    }
+    slices_.clear();
+    spill_.clear();
+    first_ = 0;
+    buffer_used_ = 0;
+    error_ = 0;
+    return true;
+  }
+
+  // 尚未写出的字节数
+  size_t pending_bytes() const noexcept
+  {
+    return pending_bytes_;
+  }
+
+  // 尚未写出的 iovec 个数
+  size_t pending_slices() const noexcept
+  {
+    return slices_.size() - first_;
+  }
+
+  // 最近一次写入失败的 errno, 成功 flush 后清零
+  int error() const noexcept
+  {
+    return error_;
+  }
+
+  int fd() const noexcept
+  {
+    return fd_;
+  }
+
+ private:
+  void push_slice(const char *p, size_t n)
+  {
+    detail::io_slice s;
+    s.iov_base = const_cast<char *>(p);  // NOLINT(cppcoreguidelines-pro-type-const-cast): writev 不修改数据
+    s.iov_len = n;
+    slices_.push_back(s);
+    pending_bytes_ += n;
+  }
+
+  // 跳过已写出的 n 字节: 整段写完的片段直接丢弃, 部分写出的片段调整起点
+  void consume(size_t n) noexcept
+  {
+    pending_bytes_ -= n;
+    while (n != 0 && first_ < slices_.size())
+    {
+      detail::io_slice &s = slices_[first_];
+      if (n >= s.iov_len)
+      {
+        n -= s.iov_len;
+        ++first_;
+      }
+      else
+      {
+        s.iov_base = static_cast<char *>(s.iov_base) + n;
+        s.iov_len -= n;
+        n = 0;
+      }
+    }
+  }
+
+  int fd_;
+  size_t batch_limit_;
+  size_t copy_threshold_;
+  std::unique_ptr<char[]> buffer_;
+  size_t buffer_capacity_;
+  size_t buffer_used_;
+  std::vector<detail::io_slice> slices_;
+  std::vector<std::unique_ptr<char[]>> spill_;  // 缓冲区无法腾空时短片段的副本
+  size_t first_;  // slices_ 中第一个未写完的片段
+  size_t pending_bytes_;
+  int error_;
+};
+
+}  // namespace abin
@@ -0,0 +1,123 @@
+#include <functional>
+#include <sstream>
+#include <string>
+
+#include "abin/dispatch.h"
+#include "abin/string_view.h"
+#include "catch2/catch.hpp"
+#include "test_util.h"
+
+using abin::dispatch::isa;
+
+namespace
+{
+
+// 最高的 k 个代码单元(靠近 0xFFFF / 0xFFFFFFFF), 作为字母表覆盖符号位与代理项区间
+template <typename CharT>
+std::basic_string<CharT> high_units(uint32_t k)
+{
+  std::basic_string<CharT> s;
+  for (uint32_t i = 0; i < k; ++i) s.push_back(static_cast<CharT>(static_cast<uint32_t>(-1) - i));
+  return s;
+}
+
+// 以 std::basic_string 作为参考实现逐项对照
+template <typename CharT>
+void check_against_std()
+{
+  using sv_type = abin::basic_string_view<CharT>;
+  const isa all[] = {isa::scalar, isa::sse2, isa::ssse3, isa::avx2};
+  for (isa level : all)
+  {
+    if (!abin::dispatch::force_isa(level)) continue;
+    INFO("isa = " << abin::dispatch::isa_name(level) << ", unit = " << sizeof(CharT));
+
+    test_util::lcg rng(11);
+    const std::basic_string<CharT> three = high_units<CharT>(3);
+    const std::basic_string<CharT> two = high_units<CharT>(2);
+    for (int round = 0; round < 300; ++round)
+    {
+      const std::basic_string<CharT> hay = test_util::random_string(static_cast<size_t>(round % 90), rng, three);
+      const std::basic_string<CharT> needle = test_util::random_string(static_cast<size_t>(1 + round % 6), rng, three);
+      const size_t pos = hay.empty() ? 0 : static_cast<size_t>(round) % hay.size();
+      const sv_type sv(hay);
+
+      REQUIRE(sv.find(needle, pos) == hay.find(needle, pos));
+      REQUIRE(sv.find(needle[0], pos) == hay.find(needle[0], pos));
+      REQUIRE(sv.rfind(needle, pos) == hay.rfind(needle, pos));
+      REQUIRE(sv.find_first_of(needle, pos) == hay.find_first_of(needle, pos));
+
+      const std::basic_string<CharT> other = test_util::random_string(hay.size(), rng, two);
+      const int expected = hay.compare(other);
+      const int actual = sv.compare(other);
+      REQUIRE((expected < 0) == (actual < 0));
+      REQUIRE((expected > 0) == (actual > 0));
+    }
+  }
+  abin::dispatch::reset_to_default();
+}
+
+}  // namespace
+
+TEST_CASE("basic_string_view char aliases")
+{
+  REQUIRE(std::is_same<abin::string_view, abin::basic_string_view<char>>::value);
+  REQUIRE(sizeof(abin::string_view) == sizeof(const char *) + sizeof(size_t));
+  REQUIRE(sizeof(abin::u32string_view) == sizeof(abin::string_view));
+}
+
+TEST_CASE("basic_string_view u16 / u32 / wchar_t operations")
+{
+  const std::u16string s16 = u"hello, 世界 world";
+  abin::u16string_view v16(s16);
+  REQUIRE(v16.size() == s16.size());
+  REQUIRE(v16.find(u"world") == 10);
+  REQUIRE(v16.find(u'界') == 8);
+  REQUIRE(v16.rfind(u'o') == 11);
+  REQUIRE(v16.starts_with(u"hello"));
+  REQUIRE(v16.ends_with(u"world"));
+  REQUIRE(v16.substr(7, 2) == u"世界");
+  REQUIRE(v16.to_string() == s16);
+
+  abin::u32string_view v32(U"\U0001F600 smile");
+  REQUIRE(v32.size() == 7);
+  REQUIRE(v32.find(U"smile") == 2);
+  REQUIRE(v32.find(U'\U0001F600') == 0);
+  REQUIRE(v32 < abin::u32string_view(U"\U0001F601"));
+  REQUIRE(U"abc" == abin::u32string_view(U"abc"));
+
+  abin::wstring_view w(L"wide string view");
+  REQUIRE(w.find(L"string") == 5);
+  REQUIRE(w.contains(L'v'));
+  REQUIRE(w.find_first_not_of(L"wide ") == 5);
+  std::wostringstream os;
+  os << w;
+  REQUIRE(os.str() == L"wide string view");
+}
+
+TEST_CASE("basic_string_view find/compare agree with std::basic_string at every isa")
+{
+  check_against_std<char16_t>();
+  check_against_std<char32_t>();
+  check_against_std<wchar_t>();
+}
+
+TEST_CASE("basic_string_view hash")
+{
+  // char 的哈希值必须与逐字节计算 h = h * 131 + c 完全一致
+  test_util::lcg rng(5);
+  const std::string bytes = high_units<char>(256);
+  for (size_t n = 0; n < 80; ++n)
+  {
+    const std::string s = test_util::random_string(n, rng, bytes);
+    size_t expected = 0;
+    for (unsigned char c : s) expected = expected * 131 + c;
+    REQUIRE(std::hash<abin::string_view>()(s) == expected);
+  }
+
+  const std::u16string a = u"the same text, long enough for the multi-lane path";
+  const std::u16string b = a;
+  REQUIRE(std::hash<abin::u16string_view>()(a) == std::hash<abin::u16string_view>()(b));
+  REQUIRE(std::hash<abin::u16string_view>()(a) != std::hash<abin::u16string_view>()(a.substr(1)));
+  REQUIRE(std::hash<abin::u32string_view>()(U"x") == static_cast<size_t>('x'));
+}
@@ -0,0 +1,108 @@
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "abin/bloom_filter.h"
+#include "catch2/catch.hpp"
+
+namespace
+{
+
+std::vector<std::string> make_keys(const char *prefix, size_t n)
+{
+  std::vector<std::string> keys;
+  keys.reserve(n);
+  for (size_t i = 0; i < n; ++i) keys.push_back(prefix + std::to_string(i * 2654435761U));
+  return keys;
+}
+
+}  // namespace
+
+TEST_CASE("bloom_filter has no false negatives and honours the false-positive rate")
+{
+  const std::vector<std::string> present = make_keys("user:", 20000);
+  for (double rate : {0.1, 0.01, 0.001, 1e-4, 1e-5})
+  {
+    INFO("rate = " << rate);
+    const abin::bloom_filter filter(present.begin(), present.end(), rate);
+    REQUIRE(filter.key_count() == present.size());
+    for (const std::string &k : present) REQUIRE(filter.may_contain(k));
+    // 查询次数使期望的假阳性个数约为 100, 统计波动远小于 1.5 倍的容差.
+    // 键为 "other:<十进制数>", 这类结构相近的文本键也能暴露 hash 混合不足的问题
+    const size_t queries = static_cast<size_t>(100 / rate);
+    size_t false_positives = 0;
+    char key[32] = "other:";
+    for (size_t i = 0; i < queries; ++i)
+    {
+      size_t len = 6;
+      for (uint64_t v = i * 2654435761ULL + 1; v != 0; v /= 10) key[len++] = static_cast<char>('0' + v % 10);
+      false_positives += filter.may_contain(abin::string_view(key, len)) ? 1 : 0;
+    }
+    REQUIRE(static_cast<double>(false_positives) / static_cast<double>(queries) < rate * 1.5);
+  }
+
+  abin::bloom_filter empty(0);
+  REQUIRE(!empty.may_contain("anything"));
+  empty.add("");
+  REQUIRE(empty.may_contain(""));
+}
+
+TEST_CASE("bloom_filter batch queries match single queries")
+{
+  const std::vector<std::string> present = make_keys("k", 1000);
+  abin::bloom_filter filter(present.size(), 0.05);
+  for (const std::string &k : present) filter.add(k);
+
+  std::vector<abin::string_view> queries;
+  const std::vector<std::string> absent = make_keys("x", 1000);
+  for (size_t i = 0; i < 1000; ++i)
+  {
+    queries.push_back(present[i]);
+    queries.push_back(absent[i]);
+  }
+  queries.push_back("tail");  // 不是批大小的整数倍
+
+  std::unique_ptr<bool[]> results(new bool[queries.size()]);
+  const size_t hits = filter.may_contain_many(queries.data(), queries.size(), results.get());
+  size_t expected = 0;
+  for (size_t i = 0; i < queries.size(); ++i)
+  {
+    REQUIRE(results[i] == filter.may_contain(queries[i]));
+    expected += results[i] ? 1 : 0;
+  }
+  REQUIRE(hits == expected);
+  REQUIRE(hits >= present.size());
+}
+
+TEST_CASE("bloom_filter serializes to a flat buffer usable in place")
+{
+  const std::vector<std::string> keys = make_keys("word", 5000);
+  const abin::bloom_filter filter(keys.begin(), keys.end(), 0.01);
+  const abin::bloom_filter copy = filter;
+  for (const std::string &k : keys) REQUIRE(copy.may_contain(k));
+
+  // uint64_t 存储保证 8 字节对齐, 模拟 mmap 得到的内存
+  std::vector<uint64_t> storage((filter.serialized_size() + 7) / 8);
+  char *bytes = reinterpret_cast<char *>(storage.data());
+  REQUIRE(filter.serialize(bytes) == filter.serialized_size());
+
+  const abin::bloom_filter_view view(abin::string_view(bytes, filter.serialized_size()));
+  REQUIRE(view.valid());
+  REQUIRE(view.block_count() == filter.block_count());
+  REQUIRE(view.hash_count() == filter.hash_count());
+  const std::vector<std::string> others = make_keys("miss", 5000);
+  for (size_t i = 0; i < keys.size(); ++i)
+  {
+    REQUIRE(view.may_contain(keys[i]));
+    REQUIRE(view.may_contain(others[i]) == filter.may_contain(others[i]));
+  }
+
+  // 截断、篡改或未对齐的数据被拒绝; 无效视图不排除任何键
+  REQUIRE(!abin::bloom_filter_view(abin::string_view(bytes, filter.serialized_size() - 1)).valid());
+  REQUIRE(!abin::bloom_filter_view(abin::string_view(bytes + 8, 200)).valid());
+  bytes[0] = 'X';
+  const abin::bloom_filter_view bad(abin::string_view(bytes, filter.serialized_size()));
+  REQUIRE(!bad.valid());
+  REQUIRE(bad.may_contain("anything"));
+}
@@ -0,0 +1,142 @@
+#include <string>
+
+#include "abin/codec.h"
+#include "catch2/catch.hpp"
+#include "test_util.h"
+
+using abin::dispatch::isa;
+
+namespace
+{
+
+std::string to_hex(abin::string_view in, abin::hex_case letter_case = abin::hex_case::lower)
+{
+  std::string out(abin::hex_encoded_size(in.size()), '\0');
+  REQUIRE(abin::hex_encode(in, &out[0], letter_case) == out.size());
+  return out;
+}
+
+std::string to_base64(abin::string_view in)
+{
+  std::string out(abin::base64_encoded_size(in.size()), '\0');
+  REQUIRE(abin::base64_encode(in, &out[0]) == out.size());
+  return out;
+}
+
+// 参考实现: 逐字节编码
+std::string reference_base64(const std::string &in)
+{
+  const char *alphabet = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+  std::string out;
+  size_t i = 0;
+  for (; i + 3 <= in.size(); i += 3)
+  {
+    const uint32_t v = (static_cast<uint32_t>(static_cast<unsigned char>(in[i])) << 16) |
+                       (static_cast<uint32_t>(static_cast<unsigned char>(in[i + 1])) << 8) |
+                       static_cast<unsigned char>(in[i + 2]);
+    for (int k = 3; k >= 0; --k) out.push_back(alphabet[(v >> (6 * k)) & 0x3F]);
+  }
+  if (i < in.size())
+  {
+    uint32_t v = static_cast<uint32_t>(static_cast<unsigned char>(in[i])) << 16;
+    if (i + 1 < in.size()) v |= static_cast<uint32_t>(static_cast<unsigned char>(in[i + 1])) << 8;
+    out.push_back(alphabet[(v >> 18) & 0x3F]);
+    out.push_back(alphabet[(v >> 12) & 0x3F]);
+    out.push_back(i + 1 < in.size() ? alphabet[(v >> 6) & 0x3F] : '=');
+    out.push_back('=');
+  }
+  return out;
+}
+
+}  // namespace
+
+TEST_CASE("codec known vectors")
+{
+  REQUIRE(to_hex("\x01\xAB\xff") == "01abff");
+  REQUIRE(to_hex("\x01\xAB\xff", abin::hex_case::upper) == "01ABFF");
+  // RFC 4648 第 10 节
+  REQUIRE(to_base64("") == "");
+  REQUIRE(to_base64("f") == "Zg==");
+  REQUIRE(to_base64("fo") == "Zm8=");
+  REQUIRE(to_base64("foo") == "Zm9v");
+  REQUIRE(to_base64("foobar") == "Zm9vYmFy");
+
+  char buf[16];
+  abin::codec_result r = abin::base64_decode("Zm9vYg==", buf);
+  REQUIRE(r.ok());
+  REQUIRE(abin::string_view(buf, r.written) == "foob");
+  r = abin::base64_decode("Zm9vYg", buf);  // 不带填充
+  REQUIRE(r.ok());
+  REQUIRE(abin::string_view(buf, r.written) == "foob");
+  REQUIRE(abin::base64_decoded_size("Zm9vYg==") == 4);
+  REQUIRE(abin::base64_decoded_size("Zm9vYmE") == 5);
+
+  r = abin::hex_decode("0aFf", buf);
+  REQUIRE(r.ok());
+  REQUIRE(abin::string_view(buf, r.written) == "\x0a\xff");
+}
+
+TEST_CASE("codec reports error positions")
+{
+  char buf[64];
+  REQUIRE(abin::hex_decode("00zz", buf).error_pos == 2);
+  REQUIRE(abin::hex_decode("abc", buf).error_pos == 3);
+  REQUIRE(abin::base64_decode("Zm9v*mFy", buf).error_pos == 4);
+  REQUIRE(abin::base64_decode("Zm9vY", buf).error_pos == 5);
+  REQUIRE(abin::base64_decode("Zm=v", buf).error_pos == 2);
+  const abin::codec_result r = abin::base64_decode("Zm9vYmFy!", buf);
+  REQUIRE(r.error_pos == 8);
+  REQUIRE(r.written == 6);
+}
+
+TEST_CASE("codec kernels agree with the reference at every isa")
+{
+  const isa all[] = {isa::scalar, isa::sse2, isa::ssse3, isa::avx2};
+  for (isa level : all)
+  {
+    if (!abin::dispatch::force_isa(level)) continue;
+    INFO("isa = " << abin::dispatch::isa_name(level));
+    test_util::lcg rng(99);
+    const std::string bytes = test_util::all_bytes();
+    for (size_t n = 0; n < 200; ++n)
+    {
+      const std::string data = test_util::random_string(n, rng, bytes);
+      const std::string hex = to_hex(data);
+      const std::string b64 = to_base64(data);
+      REQUIRE(b64 == reference_base64(data));
+
+      // 解码结果写入精确大小的缓冲区
+      std::string decoded(abin::hex_decoded_size(hex), '\0');
+      abin::codec_result r = abin::hex_decode(hex, &decoded[0]);
+      REQUIRE(r.ok());
+      REQUIRE(decoded == data);
+      const std::string upper = to_hex(data, abin::hex_case::upper);
+      REQUIRE(abin::hex_decode(upper, &decoded[0]).ok());
+      REQUIRE(decoded == data);
+
+      decoded.assign(abin::base64_decoded_size(b64), '\0');
+      r = abin::base64_decode(b64, &decoded[0]);
+      REQUIRE(r.ok());
+      REQUIRE(r.written == n);
+      REQUIRE(decoded == data);
+
+      // 在每个位置放一个非法字符, 检查报告的位置
+      if (n > 0)
+      {
+        const size_t bad = (n * 7) % hex.size();
+        std::string broken_hex = hex;
+        broken_hex[bad] = 'g';
+        REQUIRE(abin::hex_decode(broken_hex, &decoded[0]).error_pos == bad);
+        if (b64.size() > 4)
+        {
+          // 只破坏不含填充的完整 4 字符组
+          const size_t bad64 = (n * 13) % (b64.size() - (n % 3 == 0 ? 0 : 4));
+          std::string broken_b64 = b64;
+          broken_b64[bad64] = (n % 2 == 0) ? '\x80' : '-';
+          REQUIRE(abin::base64_decode(broken_b64, &decoded[0]).error_pos == bad64);
+        }
+      }
+    }
+  }
+  abin::dispatch::reset_to_default();
+}
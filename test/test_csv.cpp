@@ -0,0 +1,173 @@
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "abin/csv.h"
+#include "catch2/catch.hpp"
+#include "test_util.h"
+
+namespace
+{
+
+using record = std::vector<std::string>;
+
+std::vector<record> read_all(abin::string_view input, char delimiter = ',')
+{
+  abin::csv_reader reader(input, delimiter);
+  std::vector<abin::string_view> fields;
+  std::vector<record> out;
+  while (reader.next(fields))
+  {
+    record r;
+    for (abin::string_view f : fields) r.push_back(f.to_string());
+    out.push_back(r);
+  }
+  return out;
+}
+
+// 参考实现: 逐字符状态机
+std::vector<record> reference_read(const std::string &s)
+{
+  std::vector<record> out;
+  size_t i = 0;
+  while (i < s.size())
+  {
+    record r;
+    for (;;)
+    {
+      std::string f;
+      if (i < s.size() && s[i] == '"')
+      {
+        for (++i; !(s[i] == '"' && (i + 1 >= s.size() || s[i + 1] != '"')); ++i)
+        {
+          f.push_back(s[i]);
+          if (s[i] == '"') ++i;
+        }
+        ++i;
+      }
+      else
+      {
+        while (i < s.size() && s[i] != ',' && s[i] != '\r' && s[i] != '\n') f.push_back(s[i++]);
+      }
+      r.push_back(f);
+      if (i < s.size() && s[i] == ',')
+      {
+        ++i;
+        continue;
+      }
+      if (i < s.size() && s[i] == '\r' && i + 1 < s.size() && s[i + 1] == '\n') ++i;
+      ++i;
+      break;
+    }
+    out.push_back(r);
+  }
+  return out;
+}
+
+}  // namespace
+
+TEST_CASE("csv reader splits plain records")
+{
+  const std::vector<record> expected = {{"a", "b", "c"}, {"1", "", "3"}, {""}, {"x", ""}};
+  REQUIRE(read_all("a,b,c\n1,,3\n\nx,\n") == expected);
+  REQUIRE(read_all("a,b,c\r\n1,,3\r\n\r\nx,") == expected);
+  REQUIRE(read_all("a,b,c\r1,,3\r\rx,\r") == expected);
+  REQUIRE(read_all("").empty());
+  REQUIRE(read_all("a;b\tc;d", ';') == std::vector<record>{{"a", "b\tc", "d"}});
+}
+
+TEST_CASE("csv reader handles quoted fields")
+{
+  const std::string input = "name,note\n\"Smith, J\",\"line1\r\nline2\"\n\"say \"\"hi\"\"\",\"\"\n\"\"\"\"\n";
+  const std::vector<record> expected = {
+    {"name", "note"}, {"Smith, J", "line1\r\nline2"}, {"say \"hi\"", ""}, {"\""}};
+  REQUIRE(read_all(input) == expected);
+
+  // 没有双写引号的字段直接引用输入, 有双写引号的字段在暂存区中
+  abin::csv_reader reader(input);
+  std::vector<abin::string_view> fields;
+  REQUIRE(reader.next(fields));
+  REQUIRE(reader.next(fields));
+  REQUIRE(fields[0].data() == input.data() + 11);
+  REQUIRE(reader.next(fields));
+  REQUIRE(fields[0] == "say \"hi\"");
+  REQUIRE((fields[0].data() < input.data() || fields[0].data() >= input.data() + input.size()));
+  REQUIRE(reader.next(fields));
+  REQUIRE(!reader.next(fields));
+  REQUIRE(reader.records() == 4);
+  REQUIRE(reader.error() == abin::csv_error::none);
+  REQUIRE(reader.consumed() == input.size());
+
+  // 未加引号字段中的引号按普通字符处理
+  REQUIRE(read_all("a\"b,c\n") == std::vector<record>{{"a\"b", "c"}});
+}
+
+TEST_CASE("csv reader reports malformed quotes")
+{
+  std::vector<abin::string_view> fields;
+  abin::csv_reader r1("a,b\n\"open,c\n");
+  REQUIRE(r1.next(fields));
+  REQUIRE(!r1.next(fields));
+  REQUIRE(fields.empty());
+  REQUIRE(r1.error() == abin::csv_error::unterminated_quote);
+  REQUIRE(r1.error_pos() == 4);
+
+  abin::csv_reader r2("\"ab\"c,d\n");
+  REQUIRE(!r2.next(fields));
+  REQUIRE(r2.error() == abin::csv_error::text_after_quote);
+  REQUIRE(r2.error_pos() == 4);
+  REQUIRE(!r2.next(fields));  // 出错后不再继续
+}
+
+TEST_CASE("csv reader resumes across chunks")
+{
+  const std::string input = "id,text\n1,\"multi\nline \"\"quoted\"\"\"\n2,plain\r\n3,\"last\"\n";
+  const std::vector<record> expected = read_all(input);
+  REQUIRE(expected.size() == 4);
+
+  for (size_t chunk = 1; chunk <= input.size(); ++chunk)
+  {
+    std::vector<record> got;
+    std::string carry;
+    std::vector<abin::string_view> fields;
+    for (size_t off = 0; off < input.size(); off += chunk)
+    {
+      carry += input.substr(off, chunk);
+      const bool last = off + chunk >= input.size();
+      abin::csv_reader reader(carry, ',', '"', last);
+      while (reader.next(fields))
+      {
+        record r;
+        for (abin::string_view f : fields) r.push_back(f.to_string());
+        got.push_back(r);
+      }
+      REQUIRE(reader.error() == abin::csv_error::none);
+      carry.erase(0, reader.consumed());
+    }
+    REQUIRE(got == expected);
+  }
+}
+
+TEST_CASE("csv reader agrees with a character-at-a-time parser")
+{
+  const char alphabet[] = "ab,\"\n\r";
+  test_util::lcg rng(7);
+  int checked = 0;
+  for (int iter = 0; iter < 3000; ++iter)
+  {
+    const std::string s = test_util::random_string(rng.below(40), rng, alphabet);
+    abin::csv_reader reader(s);
+    std::vector<abin::string_view> fields;
+    std::vector<record> got;
+    while (reader.next(fields))
+    {
+      record r;
+      for (abin::string_view f : fields) r.push_back(f.to_string());
+      got.push_back(r);
+    }
+    if (reader.error() != abin::csv_error::none) continue;  // 参考实现只处理合法输入
+    REQUIRE(got == reference_read(s));
+    ++checked;
+  }
+  REQUIRE(checked > 100);
+}
@@ -0,0 +1,104 @@
+#include <string>
+
+#include "abin/dispatch.h"
+#include "abin/string_view.h"
+#include "abin/utf8.h"
+#include "catch2/catch.hpp"
+#include "test_util.h"
+
+using abin::string_view;
+using abin::dispatch::function;
+using abin::dispatch::isa;
+
+namespace
+{
+
+// 朴素的参考实现
+size_t naive_find(const std::string &s, const std::string &needle, size_t pos)
+{
+  if (pos > s.size()) return string_view::npos;
+  for (size_t i = pos; i + needle.size() <= s.size(); ++i)
+  {
+    if (s.compare(i, needle.size(), needle) == 0) return i;
+  }
+  return string_view::npos;
+}
+
+}  // namespace
+
+TEST_CASE("dispatch isa names")
+{
+  isa level = isa::scalar;
+  REQUIRE(abin::dispatch::parse_isa("AVX2", level));
+  REQUIRE(level == isa::avx2);
+  REQUIRE(abin::dispatch::parse_isa("sse2", level));
+  REQUIRE(level == isa::sse2);
+  REQUIRE(!abin::dispatch::parse_isa("avx512", level));
+  REQUIRE(!abin::dispatch::parse_isa(nullptr, level));
+  REQUIRE(!abin::dispatch::parse_isa("sse", level));  // 前缀不算匹配
+  REQUIRE(!abin::dispatch::parse_isa("", level));
+  REQUIRE(level == isa::sse2);
+  REQUIRE(string_view(abin::dispatch::isa_name(isa::ssse3)) == "ssse3");
+}
+
+TEST_CASE("dispatch force_isa and selected_isa")
+{
+  REQUIRE(abin::dispatch::force_isa(isa::scalar));
+  REQUIRE(abin::dispatch::selected_isa(function::find) == isa::scalar);
+  REQUIRE(abin::dispatch::requested_isa() == isa::scalar);
+
+  const isa best = abin::dispatch::best_supported_isa();
+  if (best < isa::avx2) REQUIRE(!abin::dispatch::force_isa(isa::avx2));
+
+  abin::dispatch::reset_to_default();
+  REQUIRE(abin::dispatch::selected_isa(function::find_char) ==
+          abin::dispatch::detail::effective_isa(function::find_char, best));
+  REQUIRE(abin::dispatch::requested_isa() == best);
+}
+
+TEST_CASE("dispatch every kernel agrees with the reference")
+{
+  const isa all[] = {isa::scalar, isa::sse2, isa::ssse3, isa::avx2};
+  for (isa level : all)
+  {
+    if (!abin::dispatch::force_isa(level)) continue;
+    INFO("isa = " << abin::dispatch::isa_name(level));
+
+    test_util::lcg rng(7);
+    for (int round = 0; round < 300; ++round)
+    {
+      // 小字母表让首尾字符过滤产生大量候选, 覆盖内核的各个尾部处理分支
+      const std::string hay = test_util::random_string(static_cast<size_t>(round % 150), rng, "abc");
+      const std::string needle = test_util::random_string(static_cast<size_t>(1 + round % 7), rng, "abc");
+      const size_t pos = hay.empty() ? 0 : static_cast<size_t>(round) % hay.size();
+      string_view sv(hay);
+
+      REQUIRE(sv.find(needle, pos) == naive_find(hay, needle, pos));
+      REQUIRE(sv.find(needle[0], pos) == hay.find(needle[0], pos));
+      REQUIRE(sv.rfind(needle[0], pos) == hay.rfind(needle[0], pos));
+      REQUIRE(sv.rfind(needle[0]) == hay.rfind(needle[0]));
+      REQUIRE(sv.find_first_of(needle, pos) == hay.find_first_of(needle, pos));
+      REQUIRE(sv.find_first_of("xyzc", pos) == hay.find_first_of("xyzc", pos));
+    }
+
+    // 大于 16 个字符的集合走位图路径
+    std::string text(200, 'a');
+    text[150] = 'Q';
+    REQUIRE(string_view(text).find_first_of("ABCDEFGHIJKLMNOPQRSTUVWXYZ") == 150);
+
+    REQUIRE(abin::is_valid_utf8(std::string(100, 'a') + "\xE2\x82\xAC"));
+    REQUIRE(!abin::is_valid_utf8(std::string(100, 'a') + "\xE2\x82"));
+  }
+  abin::dispatch::reset_to_default();
+}
+
+TEST_CASE("dispatch calibrate binds a supported kernel")
+{
+  abin::dispatch::calibrate();
+  for (size_t f = 0; f < abin::dispatch::function_count; ++f)
+  {
+    REQUIRE(abin::dispatch::selected_isa(static_cast<function>(f)) <= abin::dispatch::best_supported_isa());
+  }
+  REQUIRE(string_view("hello world").find("world") == 6);
+  abin::dispatch::reset_to_default();
+}
@@ -0,0 +1,95 @@
+#include <string>
+#include <vector>
+
+#include "abin/edit_distance.h"
+#include "catch2/catch.hpp"
+#include "test_util.h"
+
+namespace
+{
+
+size_t reference_distance(const std::string &a, const std::string &b)
+{
+  std::vector<size_t> prev(b.size() + 1);
+  std::vector<size_t> cur(b.size() + 1);
+  for (size_t j = 0; j <= b.size(); ++j) prev[j] = j;
+  for (size_t i = 1; i <= a.size(); ++i)
+  {
+    cur[0] = i;
+    for (size_t j = 1; j <= b.size(); ++j)
+    {
+      const size_t sub = prev[j - 1] + (a[i - 1] == b[j - 1] ? 0 : 1);
+      cur[j] = std::min(sub, std::min(prev[j], cur[j - 1]) + 1);
+    }
+    prev.swap(cur);
+  }
+  return prev[b.size()];
+}
+
+}  // namespace
+
+TEST_CASE("edit_distance basics")
+{
+  REQUIRE(abin::edit_distance("", "") == 0);
+  REQUIRE(abin::edit_distance("abc", "") == 3);
+  REQUIRE(abin::edit_distance("kitten", "sitting") == 3);
+  REQUIRE(abin::edit_distance("flaw", "lawn") == 2);
+  REQUIRE(abin::edit_distance("same", "same") == 0);
+}
+
+TEST_CASE("edit_distance agrees with the reference DP, single and multi-block")
+{
+  test_util::lcg rng(17);
+  for (int round = 0; round < 400; ++round)
+  {
+    // 长度跨越 64 与 128, 覆盖分块路径与块边界
+    const size_t la = static_cast<size_t>(round % 5 == 0 ? 60 + round % 140 : round % 40);
+    const size_t lb = static_cast<size_t>(round % 7 == 0 ? 50 + round % 150 : round % 45);
+    const std::string a = test_util::random_string(la, rng, "abcd");
+    const std::string b = test_util::random_string(lb, rng, "abcd");
+    const size_t expected = reference_distance(a, b);
+    INFO(a << " / " << b);
+    REQUIRE(abin::edit_distance(a, b) == expected);
+    for (size_t k = (expected > 2 ? expected - 2 : 0); k <= expected + 2; ++k)
+    {
+      REQUIRE(abin::within_distance(a, b, k) == (expected <= k));
+    }
+  }
+}
+
+TEST_CASE("fuzzy_find locates approximate occurrences")
+{
+  const abin::string_view hay = "the quick brwn fox jumps";
+  abin::fuzzy_match m = abin::fuzzy_find(hay, "brown", 1);
+  REQUIRE(m);
+  REQUIRE(hay.substr(m.pos, m.length) == "brwn");
+  REQUIRE(m.distance == 1);
+
+  REQUIRE(!abin::fuzzy_find(hay, "purple", 1));
+  m = abin::fuzzy_find(hay, "fox", 0);
+  REQUIRE(m.pos == 15);
+  REQUIRE(m.length == 3);
+  REQUIRE(abin::fuzzy_find(hay, "fox", 0, 16).pos == abin::string_view::npos);
+  REQUIRE(abin::fuzzy_find(hay, "ab", 2).length == 0);
+
+  // 检验结果确实满足距离约束, 且与参考实现给出的距离一致
+  test_util::lcg rng(23);
+  for (int round = 0; round < 300; ++round)
+  {
+    const std::string text = test_util::random_string(static_cast<size_t>(round % 80), rng, "abc");
+    const std::string needle = test_util::random_string(static_cast<size_t>(1 + round % 70), rng, "abc");
+    const size_t k = static_cast<size_t>(round % 4);
+    const abin::fuzzy_match r = abin::fuzzy_find(text, needle, k);
+    bool any = false;
+    for (size_t e = 0; e <= text.size() && !any; ++e)
+    {
+      for (size_t s = 0; s <= e && !any; ++s) any = reference_distance(needle, text.substr(s, e - s)) <= k;
+    }
+    REQUIRE(static_cast<bool>(r) == any);
+    if (r)
+    {
+      REQUIRE(r.distance <= k);
+      REQUIRE(reference_distance(needle, text.substr(r.pos, r.length)) == r.distance);
+    }
+  }
+}
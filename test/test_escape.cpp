@@ -0,0 +1,162 @@
+#include <cstdint>
+#include <string>
+
+#include "abin/escape.h"
+#include "catch2/catch.hpp"
+#include "test_util.h"
+
+using abin::string_view;
+using abin::dispatch::isa;
+
+namespace
+{
+
+// 约 1/4 的字节需要转义, 覆盖内核的各个尾部处理分支
+std::string escape_alphabet()
+{
+  std::string s = test_util::all_bytes();
+  for (size_t r = 0; r < 80; ++r) s[r] = static_cast<char>(r < 64 ? r % 32 : "\"\\\x7F"[r % 3]);
+  return s;
+}
+
+std::string json_escape(string_view in)
+{
+  std::string out(abin::json_escape_bound(in.size()), '\0');
+  const string_view r = abin::escape_json(in, &out[0]);
+  REQUIRE(r.size() == abin::json_escaped_size(in));
+  return r.to_string();
+}
+
+std::string c_escape(string_view in)
+{
+  std::string out(abin::c_escape_bound(in.size()), '\0');
+  const string_view r = abin::escape_c(in, &out[0]);
+  REQUIRE(r.size() == abin::c_escaped_size(in));
+  return r.to_string();
+}
+
+}  // namespace
+
+TEST_CASE("escape returns the input when nothing needs escaping")
+{
+  const std::string text = "plain text with unicode \xE4\xB8\xAD\xE6\x96\x87 and / slash, long enough for SIMD";
+  std::string buf = "untouched";
+  string_view r = abin::escape_json(text, buf);
+  REQUIRE(r.data() == text.data());
+  REQUIRE(r.size() == text.size());
+  REQUIRE(buf == "untouched");
+
+  r = abin::escape_c(text, buf);
+  REQUIRE(r.data() == text.data());
+
+  const abin::unescape_result u = abin::unescape_json(text, buf);
+  REQUIRE(u.ok());
+  REQUIRE(u.value.data() == text.data());
+  REQUIRE(abin::unescape_c(text, buf).value.data() == text.data());
+  REQUIRE(buf == "untouched");
+
+  REQUIRE(abin::escape_json(string_view(), buf).empty());
+  REQUIRE(abin::unescape_json(string_view(), buf).ok());
+}
+
+TEST_CASE("escape_json known vectors")
+{
+  REQUIRE(json_escape("say \"hi\"\n") == "say \\\"hi\\\"\\n");
+  REQUIRE(json_escape("a\\b") == "a\\\\b");
+  REQUIRE(json_escape(string_view("\b\f\r\t\x01\x1F", 6)) == "\\b\\f\\r\\t\\u0001\\u001f");
+  REQUIRE(json_escape(string_view("\0x", 2)) == "\\u0000x");
+  REQUIRE(json_escape("\x7F") == "\x7F");
+
+  std::string buf;
+  const string_view r = abin::escape_json("tab\there", buf);
+  REQUIRE(r == "tab\\there");
+  REQUIRE(r.data() == buf.data());
+}
+
+TEST_CASE("escape_c known vectors")
+{
+  REQUIRE(c_escape("say \"hi\"\n") == "say \\\"hi\\\"\\n");
+  REQUIRE(c_escape("\a\b\f\r\t\v\\") == "\\a\\b\\f\\r\\t\\v\\\\");
+  REQUIRE(c_escape(string_view("\0" "1", 2)) == "\\0001");
+  REQUIRE(c_escape("\x7F\x1B") == "\\177\\033");
+  REQUIRE(c_escape("\xC3\xA9'") == "\xC3\xA9'");
+}
+
+TEST_CASE("unescape_json known vectors and errors")
+{
+  std::string buf;
+  abin::unescape_result r = abin::unescape_json("a\\\"b\\\\c\\/d\\b\\f\\n\\r\\t", buf);
+  REQUIRE(r.ok());
+  REQUIRE(r.value == "a\"b\\c/d\b\f\n\r\t");
+
+  REQUIRE(abin::unescape_json("\\u0041\\u00e9\\u4E2D", buf).value == "A\xC3\xA9\xE4\xB8\xAD");
+  REQUIRE(abin::unescape_json("\\ud83d\\ude00!", buf).value == "\xF0\x9F\x98\x80!");
+  REQUIRE(abin::unescape_json("\\u0000", buf).value == string_view("\0", 1));
+
+  r = abin::unescape_json("ok\\x", buf);
+  REQUIRE(!r);
+  REQUIRE(r.error_pos == 2);
+  REQUIRE(r.value == "ok");
+  REQUIRE(abin::unescape_json("abc\\", buf).error_pos == 3);
+  REQUIRE(abin::unescape_json("\\u12", buf).error_pos == 0);
+  REQUIRE(abin::unescape_json("\\u12g4", buf).error_pos == 0);
+  REQUIRE(abin::unescape_json("x\\ud83d", buf).error_pos == 1);           // 缺少低代理项
+  REQUIRE(abin::unescape_json("x\\ud83d\\u0041", buf).error_pos == 1);    // 低代理项不合法
+  REQUIRE(abin::unescape_json("\\n\\ude00", buf).error_pos == 2);         // 孤立的低代理项
+}
+
+TEST_CASE("unescape_c known vectors and errors")
+{
+  std::string buf;
+  abin::unescape_result r = abin::unescape_c("\\a\\b\\f\\n\\r\\t\\v\\\\\\'\\\"\\?", buf);
+  REQUIRE(r.ok());
+  REQUIRE(r.value == "\a\b\f\n\r\t\v\\'\"?");
+
+  REQUIRE(abin::unescape_c("\\0\\101\\1012\\x41\\x7f!", buf).value == string_view("\0AA2A\x7F!", 7));
+  REQUIRE(abin::unescape_c("\\x0041", buf).value == "A");
+
+  REQUIRE(abin::unescape_c("ab\\q", buf).error_pos == 2);
+  REQUIRE(abin::unescape_c("\\x", buf).error_pos == 0);
+  REQUIRE(abin::unescape_c("\\x100", buf).error_pos == 0);
+  REQUIRE(abin::unescape_c("\\n\\400", buf).error_pos == 2);
+  REQUIRE(abin::unescape_c("end\\", buf).error_pos == 3);
+}
+
+TEST_CASE("escape round-trips at every isa")
+{
+  const isa all[] = {isa::scalar, isa::sse2, isa::ssse3, isa::avx2};
+  const std::string alphabet = escape_alphabet();
+  for (isa level : all)
+  {
+    if (!abin::dispatch::force_isa(level)) continue;
+    INFO("isa = " << abin::dispatch::isa_name(level));
+    test_util::lcg rng(2024);
+    for (size_t n = 0; n < 200; ++n)
+    {
+      const std::string data = test_util::random_string(n, rng, alphabet);
+      std::string buf;
+
+      const std::string json = json_escape(data);
+      for (char ch : json) REQUIRE(static_cast<unsigned char>(ch) >= 0x20);
+      abin::unescape_result r = abin::unescape_json(json, buf);
+      REQUIRE(r.ok());
+      REQUIRE(r.value == data);
+
+      const std::string c = c_escape(data);
+      REQUIRE(c.find('\x7F') == std::string::npos);
+      r = abin::unescape_c(c, buf);
+      REQUIRE(r.ok());
+      REQUIRE(r.value == data);
+
+      // 把某个位置改成需要转义的字符, 向量内核必须找到它
+      std::string clean(n, 'a');
+      REQUIRE(json_escape(clean) == clean);
+      if (n > 0)
+      {
+        clean[(n * 37 + 11) % n] = '\x1F';
+        REQUIRE(json_escape(clean).size() == n + 5);
+      }
+    }
+  }
+  abin::dispatch::reset_to_default();
+}
@@ -0,0 +1,118 @@
+#include <string>
+#include <vector>
+
+#include "abin/glob.h"
+#include "catch2/catch.hpp"
+#include "test_util.h"
+
+namespace
+{
+
+// 参考实现: 动态规划, 只支持 `*`、`?` 与字面量
+bool reference_match(const std::string &pat, const std::string &text)
+{
+  std::vector<std::vector<char>> dp(pat.size() + 1, std::vector<char>(text.size() + 1, 0));
+  dp[0][0] = 1;
+  for (size_t i = 1; i <= pat.size(); ++i)
+  {
+    for (size_t j = 0; j <= text.size(); ++j)
+    {
+      if (pat[i - 1] == '*')
+        dp[i][j] = static_cast<char>(dp[i - 1][j] || (j > 0 && dp[i][j - 1]));
+      else if (j > 0)
+        dp[i][j] = static_cast<char>(dp[i - 1][j - 1] && (pat[i - 1] == '?' || pat[i - 1] == text[j - 1]));
+    }
+  }
+  return dp[pat.size()][text.size()] != 0;
+}
+
+}  // namespace
+
+TEST_CASE("glob basic syntax")
+{
+  abin::glob g("svc.*.latency.p9?");
+  REQUIRE(g.match("svc.api.latency.p99"));
+  REQUIRE(g.match("svc..latency.p95"));
+  REQUIRE(!g.match("svc.api.latency.p999"));
+  REQUIRE(!g.match("svc.api.errors.p99"));
+  REQUIRE(g.literal_prefix() == "svc.");
+  REQUIRE(g.literal_suffix() == "");
+  REQUIRE(g.required_literal() == ".latency.p9");
+  REQUIRE(g.min_length() == 16);
+
+  REQUIRE(abin::glob("*").match(""));
+  REQUIRE(abin::glob("").match(""));
+  REQUIRE(!abin::glob("").match("a"));
+  REQUIRE(abin::glob("a**b").match("ab"));
+  REQUIRE(abin::glob("a*a").match("aa"));
+  REQUIRE(!abin::glob("a*a").match("a"));
+}
+
+TEST_CASE("glob character classes and escapes")
+{
+  REQUIRE(abin::glob("host[0-9][0-9]").match("host42"));
+  REQUIRE(!abin::glob("host[0-9][0-9]").match("host4x"));
+  REQUIRE(abin::glob("[!a-z]*").match("Xyz"));
+  REQUIRE(!abin::glob("[^a-z]*").match("xyz"));
+  REQUIRE(abin::glob("[]]").match("]"));
+  REQUIRE(abin::glob("[a-]").match("-"));
+  REQUIRE(abin::glob("\\*literal").match("*literal"));
+  REQUIRE(!abin::glob("\\*literal").match("xliteral"));
+  // 没有闭合的 '[' 按普通字符处理
+  REQUIRE(abin::glob("a[b").match("a[b"));
+}
+
+TEST_CASE("glob agrees with the reference matcher")
+{
+  test_util::lcg rng(3);
+  for (int round = 0; round < 3000; ++round)
+  {
+    const std::string pat = test_util::random_string(static_cast<size_t>(round % 9), rng, "ab?*");
+    const std::string text = test_util::random_string(static_cast<size_t>(round % 13), rng, "ab");
+    INFO(pat << " ~ " << text);
+    REQUIRE(abin::glob(pat).match(text) == reference_match(pat, text));
+  }
+}
+
+TEST_CASE("glob long segments and pathological patterns")
+{
+  // 反例都能通过长度、首尾字面量与必需字面量的预过滤, 只会在中间段的 Shift-And 搜索中失败:
+  // 唯一的 'y' 紧跟在 'x' 之后, 它前面凑不够段中 '?' 的个数
+
+  // 超过 64 个位置的段使用多字 Shift-And
+  const std::string seg(100, '?');
+  abin::glob g("x*" + seg + "y*z");
+  REQUIRE(g.match("x" + std::string(150, 'q') + "yz"));
+  const std::string g_miss = "xy" + std::string(150, 'q') + "z";
+  REQUIRE(g_miss.size() >= g.min_length());
+  REQUIRE(!g.match(g_miss));
+
+  // 超过 stack_state_positions 的段在堆上分配状态
+  const std::string huge(abin::glob::stack_state_positions + 37, '?');
+  abin::glob h("x*" + huge + "y*z");
+  REQUIRE(h.match("x" + std::string(huge.size() + 20, 'q') + "yqz"));
+  const std::string h_miss = "xy" + std::string(huge.size() + 20, 'q') + "z";
+  REQUIRE(h_miss.size() >= h.min_length());
+  REQUIRE(!h.match(h_miss));
+
+  // 回溯匹配器在此类输入上是指数级的; 文本以 "ab" 结尾, 能通过所有预过滤, 由第二个 "ab" 段的搜索判定失败
+  abin::glob bad("*ab*ab*ab*ab*ab*ab*ab*ab*");
+  const std::string bad_text = std::string(20000, 'a') + "ab";
+  REQUIRE(bad_text.size() >= bad.min_length());
+  REQUIRE(bad.required_literal() == "ab");
+  REQUIRE(!bad.match(bad_text));
+  REQUIRE(bad.match(std::string(20000, 'a') + "abababababababab"));
+}
+
+TEST_CASE("glob batch matching")
+{
+  abin::glob g("*.p99");
+  const std::vector<abin::string_view> names = {"a.p99", "b.p50", "c.p99", "p99"};
+  bool results[4] = {false, false, false, false};
+  REQUIRE(g.match_many(names.data(), names.size(), results) == 2);
+  REQUIRE(results[0]);
+  REQUIRE(!results[1]);
+  REQUIRE(results[2]);
+  REQUIRE(!results[3]);
+  REQUIRE(g.filter(names) == std::vector<size_t>{0, 2});
+}
@@ -0,0 +1,66 @@
+#include <functional>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+
+#include "abin/hashed_string_view.h"
+#include "abin/rolling_hash.h"
+#include "catch2/catch.hpp"
+
+TEST_CASE("hashed_string_view carries the std::hash value")
+{
+  const std::string text = "GET /api/users HTTP/1.1";
+  const abin::hashed_string_view key(abin::string_view(text).substr(4, 10));
+  REQUIRE(key.view() == "/api/users");
+  REQUIRE(key.hash() == std::hash<abin::string_view>()("/api/users"));
+  REQUIRE(std::hash<abin::hashed_string_view>()(key) == key.hash());
+  REQUIRE(abin::hashed_hash()(key) == abin::hashed_hash()(abin::string_view("/api/users")));
+  REQUIRE(abin::hashed_string_view().hash() == std::hash<abin::string_view>()(""));
+
+  // 已知 hash 时不再扫描内容, 例如滚动 hash 的窗口值
+  abin::for_each_window(text, 4, [&text](size_t pos, size_t h) {
+    const abin::hashed_string_view w(abin::string_view(text).substr(pos, 4), h);
+    REQUIRE(w == abin::hashed_string_view(abin::string_view(text).substr(pos, 4)));
+  });
+}
+
+TEST_CASE("hashed_string_view comparisons")
+{
+  const abin::hashed_string_view a("alpha");
+  const std::string alpha = "alpha";
+  REQUIRE(a == abin::hashed_string_view(alpha));
+  REQUIRE(a == "alpha");
+  REQUIRE("alpha" == a);
+  REQUIRE(a == alpha);
+  REQUIRE(alpha == a);
+  REQUIRE(a == abin::string_view("alpha"));
+  REQUIRE(abin::string_view("alpha") == a);
+  REQUIRE(a != "alphA");
+  REQUIRE(a != abin::hashed_string_view("beta"));
+  REQUIRE(abin::string_view("x") == "x");  // 包含本头文件后, string_view 自身的比较仍无二义性
+
+  // hash 不同即可判定不等, 不必比较字节; hash 相同仍需比较字节
+  const abin::hashed_string_view forged(abin::string_view("beta"), a.hash());
+  REQUIRE(forged != a);
+  REQUIRE(abin::hashed_equal()(a, abin::string_view("alpha")));
+  REQUIRE(!abin::hashed_equal()(abin::string_view("alpha"), forged));
+}
+
+TEST_CASE("hashed_string_view as an unordered_map key")
+{
+  std::unordered_map<abin::hashed_string_view, int> routes;
+  std::unordered_set<abin::hashed_string_view, abin::hashed_hash, abin::hashed_equal> seen;
+  routes[abin::hashed_string_view("/users")] = 1;
+  routes[abin::hashed_string_view("/orders")] = 2;
+  seen.insert(abin::hashed_string_view("/users"));
+
+  // 一次计算 hash, 在多个表中查找; 可以作为 string_view 使用
+  const std::string request = "/users";
+  const abin::hashed_string_view key(request);
+  REQUIRE(routes.at(key) == 1);
+  REQUIRE(seen.count(key) == 1);
+  const abin::string_view plain = key;
+  REQUIRE(plain.data() == request.data());
+  REQUIRE(routes.find(abin::hashed_string_view(abin::string_view("/orders")))->second == 2);
+  REQUIRE(routes.find(abin::hashed_string_view("/missing")) == routes.end());
+}
@@ -0,0 +1,96 @@
+#include <cstdint>
+#include <functional>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "abin/rolling_hash.h"
+#include "catch2/catch.hpp"
+#include "test_util.h"
+
+namespace
+{
+
+// 以 0x00 ~ 0xFF 全部字节为字母表的伪随机数据
+std::string random_bytes(size_t n, uint32_t seed)
+{
+  test_util::lcg rng(seed);
+  return test_util::random_string(n, rng, test_util::all_bytes());
+}
+
+}  // namespace
+
+TEST_CASE("rolling_hash equals std::hash of every window")
+{
+  const std::string text = random_bytes(500, 42) + "abcabcabc";
+  for (size_t w : {size_t{1}, size_t{3}, size_t{16}, size_t{64}})
+  {
+    size_t calls = 0;
+    abin::for_each_window(text, w, [&](size_t pos, size_t h) {
+      REQUIRE(h == std::hash<abin::string_view>()(abin::string_view(text).substr(pos, w)));
+      ++calls;
+    });
+    REQUIRE(calls == text.size() - w + 1);
+  }
+
+  abin::rolling_hash h(3);
+  for (char c : std::string("abc")) h.push(c);
+  REQUIRE(h.full());
+  const size_t abc = h.value();
+  h.roll('a', 'a');  // "bca"
+  h.roll('b', 'b');  // "cab"
+  h.roll('c', 'c');  // "abc"
+  REQUIRE(h.value() == abc);
+  h.reset();
+  REQUIRE(h.value() == 0);
+  REQUIRE(h.size() == 0);
+
+  size_t calls = 0;
+  abin::for_each_window("ab", 3, [&](size_t, size_t) { ++calls; });
+  REQUIRE(calls == 0);
+}
+
+TEST_CASE("cdc_chunker respects size bounds and covers the input")
+{
+  const std::string data = random_bytes(1 << 20, 7);
+  const abin::cdc_chunker chunker(2048, 8192, 65536);
+  const std::vector<abin::string_view> chunks = chunker.split(data);
+  REQUIRE(chunks.size() > 1);
+
+  size_t offset = 0;
+  for (size_t i = 0; i < chunks.size(); ++i)
+  {
+    REQUIRE(chunks[i].data() == data.data() + offset);
+    REQUIRE(chunks[i].size() <= chunker.max_size());
+    if (i + 1 < chunks.size()) REQUIRE(chunks[i].size() >= chunker.min_size());
+    offset += chunks[i].size();
+  }
+  REQUIRE(offset == data.size());
+
+  // 归一化分块使平均长度接近 avg
+  const size_t average = data.size() / chunks.size();
+  REQUIRE(average > 4096);
+  REQUIRE(average < 16384);
+
+  // 没有内容定义的切分点时按 max_size 切分
+  const std::string zeros(100000, '\0');
+  const abin::cdc_chunker small(16, 64, 256);
+  for (abin::string_view c : small.split(zeros)) REQUIRE(c.size() <= 256);
+  REQUIRE(small.cut(abin::string_view(zeros).substr(0, 10)) == 10);
+}
+
+TEST_CASE("cdc_chunker boundaries survive an insertion")
+{
+  const std::string data = random_bytes(1 << 18, 99);
+  std::string edited = data;
+  edited.insert(100000, "inserted bytes");
+
+  const abin::cdc_chunker chunker(512, 2048, 8192);
+  std::set<std::string> before;
+  for (abin::string_view c : chunker.split(data)) before.insert(c.to_string());
+  size_t shared = 0;
+  const std::vector<abin::string_view> after = chunker.split(edited);
+  for (abin::string_view c : after) shared += before.count(c.to_string());
+  // 只有插入点附近的少数块发生变化
+  REQUIRE(shared + 4 >= after.size());
+}
@@ -0,0 +1,105 @@
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "abin/segmented_view.h"
+#include "catch2/catch.hpp"
+#include "test_util.h"
+
+namespace
+{
+
+// 按给定的切分点把 text 切成片段
+abin::segmented_view split_at(const std::string &text, const std::vector<size_t> &cuts)
+{
+  abin::segmented_view v;
+  size_t prev = 0;
+  for (size_t c : cuts)
+  {
+    v.push_back(abin::string_view(text).substr(prev, c - prev));
+    prev = c;
+  }
+  v.push_back(abin::string_view(text).substr(prev));
+  return v;
+}
+
+}  // namespace
+
+TEST_CASE("segmented_view access, substr and copy")
+{
+  const std::string a = "GET /index", b = "", c = ".html HT", d = "TP/1.1\r\n";
+  const abin::segmented_view v{a, b, c, d};
+  const std::string whole = a + b + c + d;
+  REQUIRE(v.size() == whole.size());
+  REQUIRE(v.segment_count() == 3);  // 空片段被忽略
+  REQUIRE(!v.contiguous());
+  for (size_t i = 0; i < whole.size(); ++i) REQUIRE(v[i] == whole[i]);
+  REQUIRE(v.front() == 'G');
+  REQUIRE(v.back() == '\n');
+  REQUIRE_THROWS_AS(v.at(whole.size()), std::out_of_range);
+  REQUIRE(v.to_string() == whole);
+
+  const abin::segmented_view mid = v.substr(4, 12);
+  REQUIRE(mid == "/index.html ");
+  REQUIRE(mid.segment_count() == 2);
+  REQUIRE(mid.segments()[0].data() == a.data() + 4);  // 不拷贝数据
+  REQUIRE(v.substr(11, 3).contiguous());
+  REQUIRE(v.substr(11, 3).as_contiguous() == "htm");
+  REQUIRE(v.substr(whole.size()).empty());
+  REQUIRE_THROWS_AS(v.substr(whole.size() + 1), std::out_of_range);
+
+  char buf[8] = {};
+  REQUIRE(v.copy(buf, 8, 7) == 8);
+  REQUIRE(std::string(buf, 8) == "dex.html");
+
+  abin::segmented_view w = v;
+  w.remove_prefix(4);
+  w.remove_suffix(2);
+  REQUIRE(w == "/index.html HTTP/1.1");
+}
+
+TEST_CASE("segmented_view comparison and hash match the contiguous string")
+{
+  const std::string text = "the quick brown fox jumps over the lazy dog";
+  const abin::segmented_view v = split_at(text, {3, 4, 15, 16, 30});
+  REQUIRE(v == abin::string_view(text));
+  REQUIRE(abin::string_view(text) == v);
+  REQUIRE(v == split_at(text, {1, 2, 40}));
+  REQUIRE(v != split_at(text + "!", {10}));
+  REQUIRE(v < "the quick brown fox jumps over the lazy dogs");
+  REQUIRE(v > "the quick brown fox");
+  REQUIRE("the quick" < v);
+  REQUIRE(v.compare(text) == 0);
+  REQUIRE(v.starts_with("the quick"));
+  REQUIRE(v.ends_with("lazy dog"));
+  REQUIRE(!v.ends_with("lazy cat"));
+  REQUIRE(abin::segmented_view().compare("") == 0);
+
+  REQUIRE(v.hash() == std::hash<abin::string_view>()(text));
+  REQUIRE(std::hash<abin::segmented_view>()(v.substr(4, 11)) == std::hash<abin::string_view>()("quick brown"));
+  REQUIRE(abin::segmented_view().hash() == std::hash<abin::string_view>()(""));
+}
+
+TEST_CASE("segmented_view find across boundaries agrees with contiguous find")
+{
+  test_util::lcg rng(12345);
+  auto next = [&rng](uint32_t mod) { return static_cast<size_t>(rng.below(mod)); };
+  for (int iter = 0; iter < 500; ++iter)
+  {
+    const size_t len = next(80);
+    const std::string text = test_util::random_string(len, rng, "abc");
+    std::vector<size_t> cuts;
+    for (size_t p = next(6); p < len; p += 1 + next(6)) cuts.push_back(p);
+    const abin::segmented_view v = split_at(text, cuts);
+    const abin::string_view sv(text);
+
+    for (int q = 0; q < 10; ++q)
+    {
+      const std::string needle = test_util::random_string(next(7), rng, "abc");
+      const size_t pos = next(static_cast<uint32_t>(len + 2));
+      REQUIRE(v.find(needle, pos) == sv.find(needle, pos));
+      if (!needle.empty()) REQUIRE(v.find(needle[0], pos) == sv.find(needle[0], pos));
+    }
+  }
+}
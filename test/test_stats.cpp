@@ -0,0 +1,102 @@
+// 该测试以 ABIN_STRING_VIEW_ENABLE_STATS=1 单独编译(见 test/CMakeLists.txt),
+// 避免与其他测试文件中关闭统计的 string_view 混用.
+#define CATCH_CONFIG_MAIN
+#include <sstream>
+#include <thread>
+
+#include "abin/stats.h"
+#include "abin/string_view.h"
+#include "catch2/catch.hpp"
+
+using abin::string_view;
+using abin::stats::operation;
+
+TEST_CASE("stats enabled")
+{
+  REQUIRE(abin::stats::enabled());
+}
+
+TEST_CASE("stats find counters")
+{
+  abin::stats::reset();
+  string_view sv = "hello world";
+
+  REQUIRE(sv.find('o') == 4);
+  REQUIRE(sv.find('z') == string_view::npos);
+  REQUIRE(sv.find("world") == 6);
+
+  const abin::stats::snapshot s = abin::stats::collect();
+  REQUIRE(s[operation::find_char].calls == 2);
+  REQUIRE(s[operation::find_char].hits == 1);
+  REQUIRE(s[operation::find_char].misses == 1);
+  REQUIRE(s[operation::find_char].bytes_scanned == 5 + 11);
+  REQUIRE(s[operation::find_char].position_histogram[abin::stats::position_bucket(4)] == 1);
+
+  REQUIRE(s[operation::find].calls == 1);
+  REQUIRE(s[operation::find].hits == 1);
+  REQUIRE(s[operation::find].bytes_scanned == 11);
+}
+
+TEST_CASE("stats predicates, compare and hash")
+{
+  abin::stats::reset();
+  string_view sv = "hello world";
+
+  REQUIRE(sv.starts_with("hello"));
+  REQUIRE(!sv.ends_with("hello"));
+  REQUIRE(sv == "hello world");
+  REQUIRE(sv.substr(6).size() == 5);
+  std::hash<string_view>()(sv);
+
+  const abin::stats::snapshot s = abin::stats::collect();
+  REQUIRE(s[operation::starts_with].hits == 1);
+  REQUIRE(s[operation::ends_with].misses == 1);
+  REQUIRE(s[operation::compare].hits == 1);
+  REQUIRE(s[operation::substr].calls == 1);
+  REQUIRE(s[operation::substr].bytes_scanned == 0);
+  REQUIRE(s[operation::hash].bytes_scanned == 11);
+}
+
+TEST_CASE("stats find_first_of is not double counted")
+{
+  abin::stats::reset();
+  string_view sv = "abcde";
+  REQUIRE(sv.find_first_of("xd") == 3);
+
+  const abin::stats::snapshot s = abin::stats::collect();
+  REQUIRE(s[operation::find_first_of].calls == 1);
+  REQUIRE(s[operation::find_char].calls == 0);
+}
+
+TEST_CASE("stats aggregate across threads")
+{
+  abin::stats::reset();
+  string_view sv = "abc";
+  std::thread t([sv] {
+    for (int i = 0; i < 100; ++i) sv.find('c');
+  });
+  t.join();
+  for (int i = 0; i < 10; ++i) sv.find('c');
+
+  REQUIRE(abin::stats::collect()[operation::find_char].calls == 110);
+
+  abin::stats::reset();
+  REQUIRE(abin::stats::collect()[operation::find_char].calls == 0);
+}
+
+TEST_CASE("stats latency sampling and dump")
+{
+  abin::stats::reset();
+  abin::stats::set_latency_sample_rate(1);
+  string_view sv = "hello world";
+  for (int i = 0; i < 8; ++i) sv.find("world");
+  abin::stats::set_latency_sample_rate(0);
+
+  const abin::stats::snapshot s = abin::stats::collect();
+  REQUIRE(s[operation::find].latency_samples == 8);
+
+  std::ostringstream oss;
+  abin::stats::dump(oss, s);
+  REQUIRE(oss.str().find("find") != std::string::npos);
+  REQUIRE(oss.str().find("hash") == std::string::npos);
+}
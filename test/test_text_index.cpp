@@ -0,0 +1,153 @@
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include "abin/text_index.h"
+#include "catch2/catch.hpp"
+#include "test_util.h"
+
+namespace
+{
+
+std::vector<size_t> naive_find_all(abin::string_view text, abin::string_view pattern)
+{
+  std::vector<size_t> out;
+  for (size_t p = text.find(pattern); p != abin::string_view::npos; p = text.find(pattern, p + 1)) out.push_back(p);
+  return out;
+}
+
+}  // namespace
+
+TEST_CASE("text_index builds a sorted suffix array with LCP")
+{
+  const std::string text = "banana";
+  const abin::text_index index(text);
+  REQUIRE(index.suffix_array() == std::vector<int32_t>{5, 3, 1, 0, 4, 2});
+  REQUIRE(index.lcp() == std::vector<int32_t>{0, 1, 3, 0, 0, 2});
+  REQUIRE(index.longest_repeat() == "ana");
+
+  test_util::lcg rng(1);
+  for (const char *alphabet : {"a", "ab", "abcd", "abcdefghijklmnopqrstuvwxyz"})
+  {
+    for (size_t n : {size_t{0}, size_t{1}, size_t{2}, size_t{3}, size_t{17}, size_t{200}, size_t{1000}})
+    {
+      const std::string s = test_util::random_string(n, rng, alphabet);
+      const abin::text_index idx(s);
+      const std::vector<int32_t> &sa = idx.suffix_array();
+      REQUIRE(sa.size() == n);
+      const abin::string_view sv(s);
+      for (size_t r = 1; r < sa.size(); ++r)
+      {
+        const abin::string_view a = sv.substr(static_cast<size_t>(sa[r - 1]));
+        const abin::string_view b = sv.substr(static_cast<size_t>(sa[r]));
+        REQUIRE(a < b);
+        size_t l = 0;
+        while (l < a.size() && l < b.size() && a[l] == b[l]) ++l;
+        REQUIRE(static_cast<size_t>(idx.lcp()[r]) == l);
+      }
+    }
+  }
+}
+
+TEST_CASE("text_index queries agree with linear search")
+{
+  test_util::lcg rng(77);
+  const std::string text = test_util::random_string(5000, rng, "abc");
+  const abin::text_index index(text);
+  const abin::string_view sv(text);
+  for (int q = 0; q < 300; ++q)
+  {
+    const std::string pattern = test_util::random_string(1 + rng.below(9), rng, "abc");
+    const std::vector<size_t> expected = naive_find_all(sv, pattern);
+    REQUIRE(index.count(pattern) == expected.size());
+    REQUIRE(index.find_all(pattern) == expected);
+    REQUIRE(index.find(pattern) == (expected.empty() ? abin::text_index::npos : expected.front()));
+    REQUIRE(index.contains(pattern) == !expected.empty());
+  }
+  REQUIRE(index.find("") == 0);
+  REQUIRE(index.count("") == text.size() + 1);
+  REQUIRE(index.find("d") == abin::text_index::npos);
+  REQUIRE(index.find(text + "a") == abin::text_index::npos);
+  REQUIRE(index.find(text) == 0);
+}
+
+TEST_CASE("text_index parallel LCP matches serial and survives save/load")
+{
+  test_util::lcg rng(5);
+  const std::string text = test_util::random_string(300000, rng, "abcd");
+  const abin::text_index serial(text, 1);
+  const abin::text_index parallel(text, 4);
+  REQUIRE(serial.suffix_array() == parallel.suffix_array());
+  REQUIRE(serial.lcp() == parallel.lcp());
+
+  const std::string path = "abin_text_index_test.bin";
+  REQUIRE(parallel.save(path));
+  abin::text_index loaded;
+  REQUIRE(loaded.load(path, text));
+  REQUIRE(loaded.suffix_array() == serial.suffix_array());
+  REQUIRE(loaded.lcp() == serial.lcp());
+  REQUIRE(loaded.find("abcd") == abin::string_view(text).find("abcd"));
+
+  // 文本内容不符时拒绝加载, 原索引不变
+  std::string other = text;
+  other[100] = other[100] == 'a' ? 'b' : 'a';
+  REQUIRE(!loaded.load(path, other));
+  REQUIRE(!loaded.load(path, abin::string_view(text).substr(1)));
+  REQUIRE(loaded.text().data() == text.data());
+  std::remove(path.c_str());
+  REQUIRE(!loaded.load(path, text));
+}
+
+TEST_CASE("text_index rejects a corrupted file body")
+{
+  test_util::lcg rng(11);
+  const std::string text = test_util::random_string(5000, rng, "abc");
+  const abin::text_index index(text);
+  const std::string path = "abin_text_index_corrupt.bin";
+  REQUIRE(index.save(path));
+
+  std::string good;
+  {
+    std::ifstream in(path, std::ios::binary);
+    good.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+  }
+  const size_t header = good.size() - 2 * text.size() * sizeof(int32_t);
+  const size_t lcp_base = header + text.size() * sizeof(int32_t);
+
+  // 在文件体的 offset 处写入 value 后尝试加载
+  const auto load_patched = [&](size_t offset, int32_t value) {
+    std::string bytes = good;
+    std::memcpy(&bytes[offset], &value, sizeof(value));
+    {
+      std::ofstream out(path, std::ios::binary | std::ios::trunc);
+      out.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+    }
+    abin::text_index loaded;
+    return loaded.load(path, text);
+  };
+
+  REQUIRE(load_patched(header, index.suffix_array()[0]));                           // 未修改
+  REQUIRE(!load_patched(header + 10 * sizeof(int32_t), 0x7fffff00));                 // 越界
+  REQUIRE(!load_patched(header + 10 * sizeof(int32_t), -1));
+  REQUIRE(!load_patched(header + 10 * sizeof(int32_t), index.suffix_array()[11]));  // 重复
+  REQUIRE(!load_patched(lcp_base, 1));                                              // lcp[0] != 0
+  REQUIRE(!load_patched(lcp_base + 20 * sizeof(int32_t), static_cast<int32_t>(text.size())));
+  // lcp 加 1 仍然不越界, 也可能与后缀顺序相容; 只能由文件头中的数组 hash 发现
+  REQUIRE(!load_patched(lcp_base + 20 * sizeof(int32_t), index.lcp()[20] + 1));
+
+  // 交换两个后缀: 仍是排列, 但不再有序
+  std::string swapped = good;
+  std::swap_ranges(&swapped[header], &swapped[header] + sizeof(int32_t), &swapped[header + 100 * sizeof(int32_t)]);
+  {
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    out.write(swapped.data(), static_cast<std::streamsize>(swapped.size()));
+  }
+  abin::text_index loaded;
+  REQUIRE(!loaded.load(path, text));
+  std::remove(path.c_str());
+}
@@ -0,0 +1,115 @@
+#include <string>
+#include <vector>
+
+#include "abin/utf8.h"
+#include "catch2/catch.hpp"
+#include "test_util.h"
+
+using abin::string_view;
+
+TEST_CASE("utf8 is_valid_utf8 - valid input")
+{
+  REQUIRE(abin::is_valid_utf8(""));
+  REQUIRE(abin::is_valid_utf8("hello world"));
+  REQUIRE(abin::is_valid_utf8("\xC3\xA9"));                  // é
+  REQUIRE(abin::is_valid_utf8("\xE4\xBD\xA0\xE5\xA5\xBD"));  // 你好
+  REQUIRE(abin::is_valid_utf8("\xF0\x9F\x98\x80"));          // U+1F600
+  REQUIRE(abin::is_valid_utf8("\xEF\xBF\xBF"));              // U+FFFF
+  REQUIRE(abin::is_valid_utf8("\xF4\x8F\xBF\xBF"));          // U+10FFFF
+}
+
+TEST_CASE("utf8 is_valid_utf8 - invalid input")
+{
+  REQUIRE(!abin::is_valid_utf8("\x80"));              // 孤立续字节
+  REQUIRE(!abin::is_valid_utf8("\xC0\xAF"));          // 过长的 2 字节编码
+  REQUIRE(!abin::is_valid_utf8("\xE0\x80\xAF"));      // 过长的 3 字节编码
+  REQUIRE(!abin::is_valid_utf8("\xF0\x80\x80\xAF"));  // 过长的 4 字节编码
+  REQUIRE(!abin::is_valid_utf8("\xED\xA0\x80"));      // 代理项 U+D800
+  REQUIRE(!abin::is_valid_utf8("\xF4\x90\x80\x80"));  // U+110000
+  REQUIRE(!abin::is_valid_utf8("\xF5\x80\x80\x80"));  // 非法前导
+  REQUIRE(!abin::is_valid_utf8("\xE4\xBD"));          // 截断
+  REQUIRE(!abin::is_valid_utf8("ab\xC3"));            // 末尾截断
+  REQUIRE(!abin::is_valid_utf8("\xC3\x28"));          // 缺少续字节
+}
+
+TEST_CASE("utf8 is_valid_utf8 - block boundaries")
+{
+  // 让多字节序列跨越 16 字节块边界, 并在每个偏移处插入错误
+  const std::string euro = "\xE2\x82\xAC";
+  for (size_t prefix = 0; prefix < 40; ++prefix)
+  {
+    std::string s(prefix, 'a');
+    s += euro;
+    s += std::string(20, 'b');
+    REQUIRE(abin::is_valid_utf8(s));
+
+    std::string truncated(prefix, 'a');
+    truncated += euro.substr(0, 2);
+    REQUIRE(!abin::is_valid_utf8(truncated));
+
+    truncated += "bbbbbbbbbbbbbbbbbbbb";
+    REQUIRE(!abin::is_valid_utf8(truncated));
+  }
+}
+
+TEST_CASE("utf8 is_valid_utf8 - agrees with scalar decoder")
+{
+  // 对大量伪随机字节序列比较向量实现与标量实现的结果.
+  // 字母表为全部字节加上多份 ASCII / 续字节 / 前导字节(约占一半), 以提高命中合法序列的概率
+  std::string alphabet = test_util::all_bytes();
+  const char pool[] = {'a',    '\x80', '\x9F', '\xA0', '\xBF', '\xC2', '\xDF',
+                       '\xE0', '\xED', '\xEF', '\xF0', '\xF4', '\xF5', '\xC0'};
+  for (int copy = 0; copy < 18; ++copy) alphabet.append(pool, sizeof(pool));
+
+  test_util::lcg rng(12345);
+  for (int round = 0; round < 2000; ++round)
+  {
+    const std::string s = test_util::random_string(static_cast<size_t>(round % 70), rng, alphabet);
+    const auto *p = reinterpret_cast<const unsigned char *>(s.data());
+    REQUIRE(abin::is_valid_utf8(s) == abin::detail::utf8_validate_scalar(p, s.size()));
+  }
+}
+
+TEST_CASE("utf8 utf8_length")
+{
+  REQUIRE(abin::utf8_length("") == 0);
+  REQUIRE(abin::utf8_length("hello") == 5);
+  REQUIRE(abin::utf8_length("\xE4\xBD\xA0\xE5\xA5\xBD") == 2);
+
+  std::string s;
+  for (int i = 0; i < 10; ++i) s += "a\xC3\xA9\xE2\x82\xAC\xF0\x9F\x98\x80";
+  REQUIRE(abin::utf8_length(s) == 40);
+}
+
+TEST_CASE("utf8 code point iteration")
+{
+  string_view sv = "a\xC3\xA9\xE2\x82\xAC\xF0\x9F\x98\x80";
+  std::vector<char32_t> cps;
+  for (char32_t cp : abin::utf8_code_points(sv)) cps.push_back(cp);
+
+  REQUIRE(cps.size() == 4);
+  REQUIRE(cps[0] == U'a');
+  REQUIRE(cps[1] == 0xE9);
+  REQUIRE(cps[2] == 0x20AC);
+  REQUIRE(cps[3] == 0x1F600);
+
+  abin::utf8_range range(sv);
+  auto it = range.begin();
+  REQUIRE(it.code_unit_count() == 1);
+  ++it;
+  REQUIRE(it.base() == sv.data() + 1);
+  REQUIRE(it.code_unit_count() == 2);
+}
+
+TEST_CASE("utf8 code point iteration - invalid bytes")
+{
+  string_view sv = "a\xFF\xE2\x82";
+  std::vector<char32_t> cps;
+  for (char32_t cp : abin::utf8_code_points(sv)) cps.push_back(cp);
+
+  REQUIRE(cps.size() == 4);
+  REQUIRE(cps[0] == U'a');
+  REQUIRE(cps[1] == 0xFFFD);
+  REQUIRE(cps[2] == 0xFFFD);
+  REQUIRE(cps[3] == 0xFFFD);
+}
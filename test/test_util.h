@@ -0,0 +1,60 @@
+// 各测试文件共用的辅助工具
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace test_util
+{
+
+// 固定种子的线性同余伪随机数生成器, 保证每次运行的输入一致.
+// 低位周期很短, 因此只使用状态的高位; 各测试自行决定如何把输出映射为字符或长度
+class lcg
+{
+ public:
+  explicit lcg(uint32_t seed) : state_(seed) {}
+
+  // 推进一步, 返回新状态
+  uint32_t next()
+  {
+    state_ = state_ * 1103515245U + 12345U;
+    return state_;
+  }
+
+  // [0, n) 内的整数(取第 16~31 位)
+  uint32_t below(uint32_t n)
+  {
+    return (next() >> 16) % n;
+  }
+
+ private:
+  uint32_t state_;
+};
+
+/**
+ * @brief 从 alphabet 中均匀抽取 n 个代码单元组成字符串
+ * @note 字符的分布由调用者通过 alphabet 控制, 例如重复某个字符以提高其出现频率
+ */
+template <typename CharT>
+std::basic_string<CharT> random_string(size_t n, lcg &rng, const std::basic_string<CharT> &alphabet)
+{
+  std::basic_string<CharT> s(n, CharT());
+  for (CharT &c : s) c = alphabet[rng.below(static_cast<uint32_t>(alphabet.size()))];
+  return s;
+}
+
+inline std::string random_string(size_t n, lcg &rng, const char *alphabet)
+{
+  return random_string(n, rng, std::string(alphabet));
+}
+
+// 0x00 ~ 0xFF 全部字节, 用作任意二进制数据的字母表
+inline std::string all_bytes()
+{
+  std::string s(256, '\0');
+  for (size_t i = 0; i < s.size(); ++i) s[i] = static_cast<char>(i);
+  return s;
+}
+
+}  // namespace test_util
@@ -0,0 +1,80 @@
+#include <algorithm>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include "abin/view_table.h"
+#include "catch2/catch.hpp"
+
+#if defined(__cpp_lib_ranges)
+static_assert(std::random_access_iterator<abin::view_table::const_iterator>,
+              "view_table::const_iterator models the C++20 random-access iterator concept");
+#endif
+
+TEST_CASE("compact_view is half the size of string_view")
+{
+  REQUIRE(sizeof(abin::compact_view) == 8);
+  REQUIRE(sizeof(abin::compact_view) * 2 == sizeof(abin::string_view));
+
+  const std::string base = "hello, world";
+  const abin::compact_view h(7, 5);
+  REQUIRE(h.resolve(base) == "world");
+  REQUIRE(h.substr(1, 3).resolve(base) == "orl");
+  REQUIRE(h.substr(5).empty());
+  REQUIRE_THROWS_AS(h.substr(6), std::out_of_range);
+  REQUIRE(h.fits(base.size()));
+  REQUIRE(!abin::compact_view(10, 5).fits(base.size()));
+  REQUIRE(h == abin::compact_view(7, 5));
+  REQUIRE(h != abin::compact_view(7, 4));
+}
+
+TEST_CASE("view_table resolves handles into the base buffer")
+{
+  const std::string csv = "alpha,beta,,gamma,delta";
+  abin::view_table table(csv);
+  abin::string_view rest(csv);
+  for (;;)
+  {
+    const size_t comma = rest.find(',');
+    table.push_back(rest.substr(0, comma));
+    if (comma == abin::string_view::npos) break;
+    rest.remove_prefix(comma + 1);
+  }
+  REQUIRE(table.size() == 5);
+  REQUIRE(table[0] == "alpha");
+  REQUIRE(table[2].empty());
+  REQUIRE(table.at(4) == "delta");
+  REQUIRE(table[4].data() == csv.data() + 18);  // 指向底层缓冲区, 没有拷贝
+  REQUIRE(table.handle(1) == abin::compact_view(6, 4));
+  REQUIRE_THROWS_AS(table.at(5), std::out_of_range);
+
+  std::vector<std::string> words;
+  for (abin::string_view w : table) words.push_back(w.to_string());
+  REQUIRE(words == std::vector<std::string>{"alpha", "beta", "", "gamma", "delta"});
+  REQUIRE(table.end() - table.begin() == 5);
+  REQUIRE(table.begin()[3] == "gamma");
+
+  // 随机访问迭代器的完整接口(C++20 代理迭代器; C++11 下的 iterator_category 为输入迭代器)
+  const abin::view_table::const_iterator first = table.begin();
+  REQUIRE(2 + first == first + 2);
+  REQUIRE(first < first + 1);
+  REQUIRE(first + 1 > first);
+  REQUIRE(first <= first);
+  REQUIRE(first >= first);
+  REQUIRE(first->size() == 5);
+  REQUIRE(std::distance(table.begin(), table.end()) == 5);
+  REQUIRE(*std::next(table.begin(), 3) == "gamma");
+  REQUIRE(*std::find_if(first + 3, table.end(), [](abin::string_view w) { return w.size() == 5; }) == "gamma");
+  REQUIRE(std::count_if(table.begin(), table.end(), [](abin::string_view w) { return w.empty(); }) == 1);
+
+  // 句柄可以排序、去重等, 之后再解析
+  std::vector<abin::compact_view> handles = table.handles();
+  std::sort(handles.begin(), handles.end(), [&table](abin::compact_view a, abin::compact_view b) {
+    return table.resolve(a) < table.resolve(b);
+  });
+  REQUIRE(table.resolve(handles[1]) == "alpha");
+  REQUIRE(table.resolve(handles.back()) == "gamma");
+
+  table.clear();
+  REQUIRE(table.empty());
+}
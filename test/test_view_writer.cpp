@@ -0,0 +1,116 @@
+#if !defined(_WIN32)
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <cstdio>
+#include <string>
+
+#include "abin/view_writer.h"
+#include "catch2/catch.hpp"
+
+namespace
+{
+
+// 读回临时文件的全部内容
+std::string read_all(int fd)
+{
+  std::string out;
+  ::lseek(fd, 0, SEEK_SET);
+  char buf[4096];
+  ssize_t n = 0;
+  while ((n = ::read(fd, buf, sizeof(buf))) > 0) out.append(buf, static_cast<size_t>(n));
+  return out;
+}
+
+}  // namespace
+
+TEST_CASE("view_writer mixes copied and zero-copy pieces")
+{
+  FILE *tmp = std::tmpfile();
+  REQUIRE(tmp != nullptr);
+  const int fd = ::fileno(tmp);
+
+  const std::string long_piece(200, 'L');
+  std::string expected;
+  {
+    abin::view_writer w(fd);
+    for (int i = 0; i < 10; ++i)
+    {
+      w << "[" << abin::string_view("INFO") << "] " << long_piece << "\n";
+      expected += "[INFO] " + long_piece + "\n";
+    }
+    // 相邻的短片段合并为同一个 iovec
+    REQUIRE(w.pending_slices() == 21);
+    REQUIRE(w.pending_bytes() == expected.size());
+    REQUIRE(w.flush());
+    REQUIRE(w.pending_bytes() == 0);
+    w << "tail";
+    expected += "tail";
+  }  // 析构时写出剩余数据
+  REQUIRE(read_all(fd) == expected);
+  std::fclose(tmp);
+}
+
+TEST_CASE("view_writer batch limit and small buffer trigger automatic flushes")
+{
+  FILE *tmp = std::tmpfile();
+  REQUIRE(tmp != nullptr);
+  const int fd = ::fileno(tmp);
+
+  std::string expected;
+  const std::string big(100, 'x');
+  {
+    abin::view_writer w(fd, 4, 8, 16);
+    for (int i = 0; i < 50; ++i)
+    {
+      const std::string small = std::to_string(i);
+      REQUIRE(w.append(small));  // 短片段已拷贝, small 随后销毁也没有问题
+      REQUIRE(w.append(big));
+      expected += small + big;
+      REQUIRE(w.pending_slices() < 4);
+    }
+  }
+  REQUIRE(read_all(fd) == expected);
+  std::fclose(tmp);
+}
+
+TEST_CASE("view_writer resumes after partial writes on a non-blocking pipe")
+{
+  int fds[2];
+  REQUIRE(::pipe(fds) == 0);
+  REQUIRE(::fcntl(fds[1], F_SETFL, ::fcntl(fds[1], F_GETFL) | O_NONBLOCK) == 0);
+
+  // 数据量超过管道容量, writev 必然出现部分写入与 EAGAIN
+  std::string payload;
+  for (int i = 0; i < 400000; ++i) payload.push_back(static_cast<char>('a' + i % 26));
+  std::string received;
+  {
+    abin::view_writer w(fds[1], 16);
+    for (size_t off = 0; off < payload.size(); off += 1000)
+    {
+      w.append(abin::string_view(payload).substr(off, 1000));
+      w.append(",");
+    }
+    char buf[65536];
+    while (!w.flush())
+    {
+      REQUIRE((w.error() == EAGAIN || w.error() == EWOULDBLOCK));
+      const ssize_t n = ::read(fds[0], buf, sizeof(buf));
+      REQUIRE(n > 0);
+      received.append(buf, static_cast<size_t>(n));
+    }
+    REQUIRE(w.error() == 0);
+  }
+  ::close(fds[1]);
+  char buf[65536];
+  ssize_t n = 0;
+  while ((n = ::read(fds[0], buf, sizeof(buf))) > 0) received.append(buf, static_cast<size_t>(n));
+  ::close(fds[0]);
+
+  std::string expected;
+  for (size_t off = 0; off < payload.size(); off += 1000) expected += payload.substr(off, 1000) + ",";
+  REQUIRE(received == expected);
+}
+
+#endif